@@ -10,7 +10,7 @@ AntUnit* AntPool::AddAnt(AgentReport report)
 	{
 		if (!m_pool[i].InUse())
 		{
-			m_pool[i].Init(report);
+			m_pool[i].Init(report, i);
 			return &m_pool[i];
 		}
 	}
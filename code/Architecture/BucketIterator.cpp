@@ -0,0 +1,27 @@
+#include "Architecture/BucketIterator.hpp"
+
+BucketIterator::BucketIterator(): QueueIterator(), m_buckets(MAX_ARENA_TILES) {}
+BucketIterator::~BucketIterator() {}
+
+//no priority given, keep the order it was pushed in relative to the current best
+void BucketIterator::Push(const int el)
+{
+	const int best_el = Peak();
+	const int priority = best_el == -1 ? 0 : m_buckets.GetPriority(best_el);
+	m_buckets.Push(el, priority);
+}
+
+void BucketIterator::PushWithPriority(const int el, const int priority)
+{
+	m_buckets.Push(el, priority);
+}
+
+void BucketIterator::Pop()
+{
+	m_buckets.Pop();
+}
+
+int BucketIterator::Peak()
+{
+	return m_buckets.Peak();
+}
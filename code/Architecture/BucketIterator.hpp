@@ -0,0 +1,19 @@
+#pragma once
+#include "Architecture/QueueIterator.hpp"
+#include "Architecture/BucketQueue.hpp"
+
+//priority frontier backed by Dial's buckets, Peak/Pop give the lowest priority tile
+class BucketIterator : public QueueIterator
+{
+public:
+	BucketIterator();
+	~BucketIterator();
+	
+	void Push(int el) override;
+	void PushWithPriority(int el, int priority) override;
+	void Pop() override;
+	int Peak() override;
+
+private:
+	BucketQueue m_buckets;
+};
@@ -0,0 +1,247 @@
+#include "Architecture/BucketQueue.hpp"
+
+
+BucketQueue::BucketQueue(const int num_keys)
+{
+	m_numKeys = num_keys;
+	m_next = new int[num_keys];
+	m_prev = new int[num_keys];
+	m_priority = new int[num_keys];
+	m_queued = new bool[num_keys];
+
+	for(int key = 0; key < m_numKeys; ++key)
+	{
+		m_next[key] = NOT_QUEUED;
+		m_prev[key] = NOT_QUEUED;
+		m_priority[key] = 0;
+		m_queued[key] = false;
+	}
+
+	for(int bucket_idx = 0; bucket_idx < NUM_BUCKETS; ++bucket_idx)
+	{
+		m_bucketHead[bucket_idx] = NOT_QUEUED;
+	}
+}
+
+
+BucketQueue::~BucketQueue()
+{
+	delete[] m_next;
+	delete[] m_prev;
+	delete[] m_priority;
+	delete[] m_queued;
+}
+
+
+//--------------------------------------------------------------------------
+// mutators
+
+
+void BucketQueue::Push(const int key, const int priority)
+{
+	if(key < 0 || key >= m_numKeys) return;
+
+	if(m_queued[key])
+	{
+		DecreaseKey(key, priority);
+		return;
+	}
+
+	int new_priority = priority;
+	if(m_size == 0)
+	{
+		m_minPriority = new_priority;
+		m_maxPriority = new_priority;
+	}
+	else
+	{
+		new_priority = ClampToWindow(new_priority);
+		if(new_priority < m_minPriority) m_minPriority = new_priority;
+		if(new_priority > m_maxPriority) m_maxPriority = new_priority;
+	}
+
+	Link(key, new_priority);
+	++m_size;
+}
+
+
+//returns NOT_QUEUED when empty, keys that share a bucket come out newest first
+int BucketQueue::Pop()
+{
+	if(m_size <= 0) return NOT_QUEUED;
+
+	AdvanceToMinBucket();
+	const int key = m_bucketHead[m_minPriority & BUCKET_MASK];
+	Unlink(key);
+	--m_size;
+
+	//the window only ever grows while keys are queued, start fresh once it drains
+	if(m_size == 0)
+	{
+		m_minPriority = 0;
+		m_maxPriority = 0;
+	}
+
+	return key;
+}
+
+
+bool BucketQueue::Remove(const int key)
+{
+	if(!Contains(key)) return false;
+
+	Unlink(key);
+	--m_size;
+
+	if(m_size == 0)
+	{
+		m_minPriority = 0;
+		m_maxPriority = 0;
+	}
+
+	return true;
+}
+
+
+//only lowers the priority, a larger value is ignored
+void BucketQueue::DecreaseKey(const int key, const int priority)
+{
+	if(!Contains(key)) return;
+
+	const int new_priority = ClampToWindow(priority);
+	if(new_priority >= m_priority[key]) return;
+
+	Unlink(key);
+	Link(key, new_priority);
+	if(new_priority < m_minPriority) m_minPriority = new_priority;
+}
+
+
+//walks every bucket once instead of every key, so clearing stays cheap on a big key range
+void BucketQueue::Clear()
+{
+	for(int bucket_idx = 0; bucket_idx < NUM_BUCKETS && m_size > 0; ++bucket_idx)
+	{
+		int key = m_bucketHead[bucket_idx];
+		while(key != NOT_QUEUED)
+		{
+			const int next_key = m_next[key];
+			m_next[key] = NOT_QUEUED;
+			m_prev[key] = NOT_QUEUED;
+			m_queued[key] = false;
+			--m_size;
+			key = next_key;
+		}
+
+		m_bucketHead[bucket_idx] = NOT_QUEUED;
+	}
+
+	m_size = 0;
+	m_minPriority = 0;
+	m_maxPriority = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// accessors
+
+
+int BucketQueue::Peak()
+{
+	if(m_size <= 0) return NOT_QUEUED;
+
+	AdvanceToMinBucket();
+	return m_bucketHead[m_minPriority & BUCKET_MASK];
+}
+
+
+int BucketQueue::GetSize() const
+{
+	return m_size;
+}
+
+
+bool BucketQueue::IsEmpty() const
+{
+	return m_size == 0;
+}
+
+
+bool BucketQueue::Contains(const int key) const
+{
+	if(key < 0 || key >= m_numKeys) return false;
+	return m_queued[key];
+}
+
+
+int BucketQueue::GetPriority(const int key) const
+{
+	if(!Contains(key)) return NOT_QUEUED;
+	return m_priority[key];
+}
+
+
+//false when a push at this priority would be clamped
+bool BucketQueue::IsInWindow(const int priority) const
+{
+	return ClampToWindow(priority) == priority;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+int BucketQueue::ClampToWindow(const int priority) const
+{
+	if(m_size == 0) return priority;
+
+	const int lowest_allowed = m_maxPriority - BUCKET_MASK;
+	const int highest_allowed = m_minPriority + BUCKET_MASK;
+
+	if(priority < lowest_allowed) return lowest_allowed;
+	if(priority > highest_allowed) return highest_allowed;
+	return priority;
+}
+
+
+void BucketQueue::Link(const int key, const int priority)
+{
+	const int bucket_idx = priority & BUCKET_MASK;
+	const int old_head = m_bucketHead[bucket_idx];
+
+	m_priority[key] = priority;
+	m_queued[key] = true;
+	m_prev[key] = NOT_QUEUED;
+	m_next[key] = old_head;
+
+	if(old_head != NOT_QUEUED) m_prev[old_head] = key;
+	m_bucketHead[bucket_idx] = key;
+}
+
+
+void BucketQueue::Unlink(const int key)
+{
+	const int bucket_idx = m_priority[key] & BUCKET_MASK;
+	const int prev_key = m_prev[key];
+	const int next_key = m_next[key];
+
+	if(prev_key != NOT_QUEUED)	m_next[prev_key] = next_key;
+	else						m_bucketHead[bucket_idx] = next_key;
+
+	if(next_key != NOT_QUEUED)	m_prev[next_key] = prev_key;
+
+	m_next[key] = NOT_QUEUED;
+	m_prev[key] = NOT_QUEUED;
+	m_queued[key] = false;
+}
+
+
+//every queued priority is inside [min, min + NUM_BUCKETS), so this scans at most one lap
+void BucketQueue::AdvanceToMinBucket()
+{
+	while(m_bucketHead[m_minPriority & BUCKET_MASK] == NOT_QUEUED)
+	{
+		++m_minPriority;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+//Dial's bucket queue for small integer priorities
+//each bucket is an intrusive doubly linked list over the keys, so push, pop
+//and decrease-key are O(1) and nothing is allocated after construction.
+//Buckets are reused in a ring, live priorities must stay within NUM_BUCKETS of
+//each other. Anything outside that window is clamped to its edge, which only
+//loosens the ordering for that key, callers that need it exact check IsInWindow first.
+class BucketQueue
+{
+public:
+	explicit BucketQueue(int num_keys);
+	~BucketQueue();
+
+	//mutators
+	void	Push(int key, int priority);
+	int		Pop();
+	bool	Remove(int key);
+	void	DecreaseKey(int key, int priority);
+	void	Clear();
+
+	//accessors
+	int		Peak();
+	int		GetSize() const;
+	bool	IsEmpty() const;
+	bool	Contains(int key) const;
+	int		GetPriority(int key) const;
+	bool	IsInWindow(int priority) const;
+
+private:
+	int		ClampToWindow(int priority) const;
+	void	Link(int key, int priority);
+	void	Unlink(int key);
+	void	AdvanceToMinBucket();
+
+public:
+	static constexpr int NUM_BUCKETS = 2048;
+	static constexpr int BUCKET_MASK = NUM_BUCKETS - 1;
+	static constexpr int NOT_QUEUED = -1;
+
+private:
+	int		m_bucketHead[NUM_BUCKETS];
+	int*	m_next;
+	int*	m_prev;
+	int*	m_priority;
+	bool*	m_queued;
+	int		m_numKeys = 0;
+	int		m_size = 0;
+	int		m_minPriority = 0;
+	int		m_maxPriority = 0;
+};
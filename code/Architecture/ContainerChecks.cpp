@@ -0,0 +1,172 @@
+#include "Architecture/ContainerChecks.hpp"
+#include "Architecture/Heap.hpp"
+#include "Architecture/BucketQueue.hpp"
+#include "Architecture/PackedPath.hpp"
+#include "Architecture/ErrorWarningAssert.hpp"
+#include <vector>
+
+
+void RunContainerChecks()
+{
+	CheckIndexedMinHeap();
+	CheckBucketQueue();
+	CheckPackedPath();
+}
+
+
+//--------------------------------------------------------------------------
+// IndexedMinHeap
+
+
+void CheckIndexedMinHeap()
+{
+	constexpr int NUM_KEYS = 64;
+	IndexedMinHeap<int> heap(NUM_KEYS, NUM_KEYS);
+
+	//37 is coprime with 64, so every key gets a distinct value in a scrambled order
+	for(int key = 0; key < NUM_KEYS; ++key)
+	{
+		heap.Push(key, (key * 37) % NUM_KEYS + 100);
+	}
+	ASSERT_OR_DIE(heap.GetSize() == NUM_KEYS, "IndexedMinHeap lost a push");
+
+	//removing the root, a leaf and everything between must leave a valid heap behind
+	const int root_key = heap.PeekKey();
+	ASSERT_OR_DIE(heap.Remove(root_key), "IndexedMinHeap could not remove its root");
+	ASSERT_OR_DIE(!heap.Contains(root_key), "IndexedMinHeap still holds a removed key");
+	ASSERT_OR_DIE(!heap.Remove(root_key), "IndexedMinHeap removed a key twice");
+	for(int key = 1; key < NUM_KEYS; key += 3)
+	{
+		if(key != root_key) heap.Remove(key);
+	}
+
+	//a larger value is ignored, a smaller one moves the key to the top
+	const int lowered_key = 63;
+	const int old_value = heap.GetItem(lowered_key);
+	heap.DecreaseKey(lowered_key, old_value + 50);
+	ASSERT_OR_DIE(heap.GetItem(lowered_key) == old_value, "IndexedMinHeap raised a key through DecreaseKey");
+	heap.DecreaseKey(lowered_key, 0);
+	ASSERT_OR_DIE(heap.PeekKey() == lowered_key, "IndexedMinHeap did not sift a decreased key up");
+
+	//a push on a queued key is a decrease key, not a second entry
+	const int size_before_push = heap.GetSize();
+	heap.Push(3, 1);
+	ASSERT_OR_DIE(heap.GetSize() == size_before_push, "IndexedMinHeap queued a key twice");
+
+	int last_value = -1;
+	int num_popped = 0;
+	while(heap.GetSize() > 0)
+	{
+		const int key = heap.PeekKey();
+		ASSERT_OR_DIE(key != root_key && (key % 3 != 1 || key == lowered_key), "IndexedMinHeap popped a removed key");
+
+		const int value = heap.Pop();
+		ASSERT_OR_DIE(value >= last_value, "IndexedMinHeap popped out of order");
+		ASSERT_OR_DIE(!heap.Contains(key), "IndexedMinHeap still holds a popped key");
+		last_value = value;
+		++num_popped;
+	}
+	ASSERT_OR_DIE(num_popped == size_before_push, "IndexedMinHeap popped the wrong number of keys");
+}
+
+
+//--------------------------------------------------------------------------
+// BucketQueue
+
+
+void CheckBucketQueue()
+{
+	constexpr int NUM_KEYS = 64;
+	BucketQueue queue(NUM_KEYS);
+
+	for(int key = 0; key < NUM_KEYS; ++key)
+	{
+		queue.Push(key, (key * 37) % NUM_KEYS);
+	}
+
+	queue.DecreaseKey(10, 70);
+	ASSERT_OR_DIE(queue.GetPriority(10) == (10 * 37) % NUM_KEYS, "BucketQueue raised a key through DecreaseKey");
+	queue.Remove(20);
+	ASSERT_OR_DIE(!queue.Contains(20), "BucketQueue still holds a removed key");
+
+	int last_priority = -1;
+	while(!queue.IsEmpty())
+	{
+		const int priority = queue.GetPriority(queue.Peak());
+		const int key = queue.Pop();
+		ASSERT_OR_DIE(key != 20, "BucketQueue popped a removed key");
+		ASSERT_OR_DIE(priority >= last_priority, "BucketQueue popped out of order");
+		last_priority = priority;
+	}
+
+	//keys that share a bucket come out newest first
+	queue.Push(1, 5);
+	queue.Push(2, 5);
+	ASSERT_OR_DIE(queue.Pop() == 2 && queue.Pop() == 1, "BucketQueue broke newest first within a bucket");
+	ASSERT_OR_DIE(queue.Pop() == BucketQueue::NOT_QUEUED, "BucketQueue popped a key while empty");
+
+	//the window is NUM_BUCKETS wide from the lowest live priority, anything past it is clamped to the edge
+	queue.Push(0, 1000);
+	ASSERT_OR_DIE(queue.IsInWindow(1000 + BucketQueue::BUCKET_MASK), "BucketQueue window is too narrow");
+	ASSERT_OR_DIE(!queue.IsInWindow(1000 + BucketQueue::NUM_BUCKETS), "BucketQueue window is too wide");
+	queue.Push(1, 1000 + 3 * BucketQueue::NUM_BUCKETS);
+	ASSERT_OR_DIE(queue.GetPriority(1) == 1000 + BucketQueue::BUCKET_MASK, "BucketQueue did not clamp a high priority");
+	ASSERT_OR_DIE(!queue.IsInWindow(0), "BucketQueue window reaches below the highest live priority");
+	queue.Push(2, 0);
+	ASSERT_OR_DIE(queue.GetPriority(2) == 1000, "BucketQueue did not clamp a low priority");
+	ASSERT_OR_DIE(queue.Pop() == 2 && queue.Pop() == 0 && queue.Pop() == 1, "BucketQueue popped clamped keys out of order");
+
+	//once drained the window starts fresh
+	queue.Push(3, 0);
+	ASSERT_OR_DIE(queue.GetPriority(3) == 0, "BucketQueue kept its window after draining");
+	queue.Clear();
+	ASSERT_OR_DIE(queue.IsEmpty() && !queue.Contains(3), "BucketQueue kept a key through Clear");
+}
+
+
+//--------------------------------------------------------------------------
+// PackedPath
+
+
+void CheckPackedPath()
+{
+	std::vector<eOrderCode> orders;
+	for(int order_idx = 0; order_idx < MAX_PATH + 16; ++order_idx)
+	{
+		const bool is_wait = order_idx < 32 && order_idx % 5 == 2;
+		orders.push_back(is_wait ? ORDER_HOLD : static_cast<eOrderCode>(ORDER_MOVE_EAST + (order_idx * 7) % 4));
+	}
+
+	PackedPath path;
+	path.Assign(orders);
+	ASSERT_OR_DIE(path.GetLength() == MAX_PATH, "PackedPath kept steps past MAX_PATH");
+	for(int step = 0; step < MAX_PATH; ++step)
+	{
+		ASSERT_OR_DIE(path.GetOrder(step) == orders[step], "PackedPath changed an order");
+	}
+	ASSERT_OR_DIE(path.GetOrder(MAX_PATH) == ORDER_HOLD && path.GetOrder(-1) == ORDER_HOLD, "PackedPath read past its ends");
+
+	eOrderCode unpacked[8];
+	const int num_unpacked = path.Unpack(unpacked, MAX_PATH - 4, 8);
+	ASSERT_OR_DIE(num_unpacked == 4, "PackedPath unpacked past its end");
+	for(int unpacked_idx = 0; unpacked_idx < num_unpacked; ++unpacked_idx)
+	{
+		ASSERT_OR_DIE(unpacked[unpacked_idx] == orders[MAX_PATH - 4 + unpacked_idx], "PackedPath unpacked the wrong order");
+	}
+
+	//a wait past the mask is dropped, the moves after it close up behind
+	std::vector<eOrderCode> late_wait(40, ORDER_MOVE_NORTH);
+	late_wait[35] = ORDER_HOLD;
+	late_wait[36] = ORDER_MOVE_WEST;
+	path.Assign(late_wait);
+	ASSERT_OR_DIE(path.GetLength() == 39, "PackedPath kept a wait past the mask");
+	ASSERT_OR_DIE(path.GetOrder(35) == ORDER_MOVE_WEST, "PackedPath did not close up behind a dropped wait");
+
+	//a reassigned path must not keep the waits of the last one
+	path.Assign(orders);
+	path.Assign(std::vector<eOrderCode>(8, ORDER_MOVE_SOUTH));
+	ASSERT_OR_DIE(path.GetLength() == 8 && path.GetOrder(2) == ORDER_MOVE_SOUTH, "PackedPath kept a stale wait");
+
+	path.Clear();
+	ASSERT_OR_DIE(path.GetLength() == 0 && path.GetOrder(0) == ORDER_HOLD, "PackedPath kept steps through Clear");
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+//self checks for the containers the searches lean on, each one dies through ASSERT_OR_DIE
+//on the first mismatch. Off by default, a build with RUN_SELF_CHECKS defined runs them once
+//at startup, they allocate and are far too slow for a turn
+void RunContainerChecks();
+void CheckIndexedMinHeap();
+void CheckBucketQueue();
+void CheckPackedPath();
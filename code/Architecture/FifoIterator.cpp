@@ -3,7 +3,7 @@
 FifoIterator::FifoIterator(const Queue collection): QueueIterator(), m_collection (collection) {}
 FifoIterator::~FifoIterator() {}
 
-void FifoIterator::Push(const short el)
+void FifoIterator::Push(const int el)
 {
 	//m_collection.m_list.push_back(el);
 }
@@ -13,7 +13,7 @@ void FifoIterator::Pop()
 	//m_collection.m_list.pop_front();
 }
 
-short FifoIterator::Peak()
+int FifoIterator::Peak()
 {
 	//return m_collection.m_list.front();
 	return -1;
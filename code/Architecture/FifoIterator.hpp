@@ -8,9 +8,9 @@ public:
 	explicit FifoIterator( Queue collection );
 	~FifoIterator();
 	
-	void Push(short el) override;
+	void Push(int el) override;
 	void Pop() override;
-	short Peak() override;
+	int Peak() override;
 
 private:
 	Queue m_collection;
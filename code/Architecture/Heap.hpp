@@ -151,21 +151,21 @@ Item MinHeap<Item>::GetReferenceAt(int idx) const
 template <typename Item>
 int MinHeap<Item>::GetLeftChildIdx(int idx)
 {
-	return 2 * idx;
+	return 2 * idx + 1;
 }
 
 
 template <typename Item>
 int MinHeap<Item>::GetRightChildIdx(int idx)
 {
-	return 2 * idx + 1;
+	return 2 * idx + 2;
 }
 
 
 template <typename Item>
 int MinHeap<Item>::GetParentIdx(int idx)
 {
-	return idx / 2;
+	return (idx - 1) / 2;
 }
 
 
@@ -201,3 +201,276 @@ void MinHeap<Item>::MinHeapify(int idx)
 		MinHeapify(smallest_value_idx); 
 	} 
 }
+
+
+//--------------------------------------------------------------------------
+// IndexedMinHeap
+// every item is pushed with a key in [0, num_keys), m_positions maps a key to
+// where the item sits in the heap, so finding an item never needs a linear scan
+
+
+template <typename Item>
+class IndexedMinHeap
+{
+public:
+	IndexedMinHeap(int size, int num_keys);
+	~IndexedMinHeap();
+
+	//mutators
+	void	Push(int key, Item value);
+	Item	Pop();
+	bool	Remove(int key);
+	void	DecreaseKey(int key, Item new_val);
+	void	Clear();
+
+	//accessors
+	int		GetSize() const;
+	bool	Contains(int key) const;
+	Item	GetItem(int key) const;
+	int		PeekKey() const;
+
+private:
+	int GetLeftChildIdx(int idx) const;
+	int GetRightChildIdx(int idx) const;
+	int GetParentIdx(int idx) const;
+	void Swap(int idx_a, int idx_b);
+	void SiftUp(int idx);
+	void SiftDown(int idx);
+
+private:
+	Item*	m_heap;
+	int*	m_heapKeys;		//key of the item at each heap slot
+	int*	m_positions;	//heap slot for each key, -1 if not in the heap
+	int		m_size;
+	int		m_capacity;
+	int		m_numKeys;
+};
+
+
+template <typename Item>
+IndexedMinHeap<Item>::IndexedMinHeap(const int size, const int num_keys)
+{
+	m_heap = new Item[size];
+	m_heapKeys = new int[size];
+	m_positions = new int[num_keys];
+	m_size = 0;
+	m_capacity = size;
+	m_numKeys = num_keys;
+
+	for(int key = 0; key < m_numKeys; ++key)
+	{
+		m_positions[key] = -1;
+	}
+}
+
+
+template <typename Item>
+IndexedMinHeap<Item>::~IndexedMinHeap()
+{
+	delete[] m_heap;
+	delete[] m_heapKeys;
+	delete[] m_positions;
+}
+
+
+template <typename Item>
+void IndexedMinHeap<Item>::Push(const int key, Item value)
+{
+	if(m_size >= m_capacity || key < 0 || key >= m_numKeys) return;
+
+	if(m_positions[key] != -1)
+	{
+		DecreaseKey(key, value);
+		return;
+	}
+
+	const int current_idx = m_size;
+	++m_size;
+	m_heap[current_idx] = value;
+	m_heapKeys[current_idx] = key;
+	m_positions[key] = current_idx;
+
+	SiftUp(current_idx);
+}
+
+
+template <typename Item>
+Item IndexedMinHeap<Item>::Pop()
+{
+	if (m_size <= 0)
+	{
+		return Item();
+	}
+
+	Item root = m_heap[0];
+	m_positions[m_heapKeys[0]] = -1;
+	--m_size;
+
+	if(m_size > 0)
+	{
+		m_heap[0] = m_heap[m_size];
+		m_heapKeys[0] = m_heapKeys[m_size];
+		m_positions[m_heapKeys[0]] = 0;
+		SiftDown(0);
+	}
+
+	return root;
+}
+
+
+template <typename Item>
+bool IndexedMinHeap<Item>::Remove(const int key)
+{
+	if(!Contains(key)) return false;
+
+	const int removed_idx = m_positions[key];
+	m_positions[key] = -1;
+	--m_size;
+
+	if(removed_idx != m_size)
+	{
+		const int moved_key = m_heapKeys[m_size];
+		m_heap[removed_idx] = m_heap[m_size];
+		m_heapKeys[removed_idx] = moved_key;
+		m_positions[moved_key] = removed_idx;
+
+		//the moved item can be smaller than its new parent, or larger than its new children
+		SiftUp(removed_idx);
+		SiftDown(m_positions[moved_key]);
+	}
+
+	return true;
+}
+
+
+//only lowers the priority, a larger value is ignored
+template <typename Item>
+void IndexedMinHeap<Item>::DecreaseKey(const int key, Item new_val)
+{
+	if(!Contains(key)) return;
+
+	const int heap_idx = m_positions[key];
+	if(m_heap[heap_idx] < new_val) return;
+
+	m_heap[heap_idx] = new_val;
+	SiftUp(heap_idx);
+}
+
+
+//only touches the slots in use, so clearing a big heap that held a few items stays cheap
+template <typename Item>
+void IndexedMinHeap<Item>::Clear()
+{
+	for(int heap_idx = 0; heap_idx < m_size; ++heap_idx)
+	{
+		m_positions[m_heapKeys[heap_idx]] = -1;
+	}
+
+	m_size = 0;
+}
+
+
+template <typename Item>
+int IndexedMinHeap<Item>::GetSize() const
+{
+	return m_size;
+}
+
+
+template <typename Item>
+bool IndexedMinHeap<Item>::Contains(const int key) const
+{
+	if(key < 0 || key >= m_numKeys) return false;
+	return m_positions[key] != -1;
+}
+
+
+template <typename Item>
+Item IndexedMinHeap<Item>::GetItem(const int key) const
+{
+	if(!Contains(key)) return Item();
+	return m_heap[m_positions[key]];
+}
+
+
+template <typename Item>
+int IndexedMinHeap<Item>::PeekKey() const
+{
+	if(m_size <= 0) return -1;
+	return m_heapKeys[0];
+}
+
+
+template <typename Item>
+int IndexedMinHeap<Item>::GetLeftChildIdx(const int idx) const
+{
+	return 2 * idx + 1;
+}
+
+
+template <typename Item>
+int IndexedMinHeap<Item>::GetRightChildIdx(const int idx) const
+{
+	return 2 * idx + 2;
+}
+
+
+template <typename Item>
+int IndexedMinHeap<Item>::GetParentIdx(const int idx) const
+{
+	return (idx - 1) / 2;
+}
+
+
+template <typename Item>
+void IndexedMinHeap<Item>::Swap(const int idx_a, const int idx_b)
+{
+	Item temp = m_heap[idx_a];
+	m_heap[idx_a] = m_heap[idx_b];
+	m_heap[idx_b] = temp;
+
+	const int temp_key = m_heapKeys[idx_a];
+	m_heapKeys[idx_a] = m_heapKeys[idx_b];
+	m_heapKeys[idx_b] = temp_key;
+
+	m_positions[m_heapKeys[idx_a]] = idx_a;
+	m_positions[m_heapKeys[idx_b]] = idx_b;
+}
+
+
+template <typename Item>
+void IndexedMinHeap<Item>::SiftUp(int idx)
+{
+	while (idx != 0 && m_heap[GetParentIdx(idx)] > m_heap[idx])
+	{
+		Swap(idx, GetParentIdx(idx));
+		idx = GetParentIdx(idx);
+	}
+}
+
+
+template <typename Item>
+void IndexedMinHeap<Item>::SiftDown(int idx)
+{
+	while(idx < m_size)
+	{
+		const int left_child = GetLeftChildIdx(idx);
+		const int right_child = GetRightChildIdx(idx);
+		int smallest_value_idx = idx;
+
+		if (left_child < m_size && m_heap[left_child] < m_heap[smallest_value_idx])
+		{
+			smallest_value_idx = left_child;
+		}
+
+		if (right_child < m_size && m_heap[right_child] < m_heap[smallest_value_idx])
+		{
+			smallest_value_idx = right_child;
+		}
+
+		if (smallest_value_idx == idx) return;
+
+		Swap(idx, smallest_value_idx);
+		idx = smallest_value_idx;
+	}
+}
@@ -0,0 +1,70 @@
+#include "Architecture/PackedPath.hpp"
+
+
+//--------------------------------------------------------------------------
+// mutators
+
+
+void PackedPath::Clear()
+{
+	m_waitMask = 0;
+	m_length = 0;
+}
+
+
+//anything past MAX_PATH is dropped, and a wait past the mask is dropped as well since it
+//only delays the ant and never changes where it ends up
+void PackedPath::Assign(const std::vector<eOrderCode>& orders)
+{
+	Clear();
+
+	const int num_orders = static_cast<int>(orders.size()) < MAX_PATH ? static_cast<int>(orders.size()) : MAX_PATH;
+	for(int order_idx = 0; order_idx < num_orders; ++order_idx)
+	{
+		const int direction = orders[order_idx] - ORDER_MOVE_EAST;
+		const bool is_wait = direction < 0 || direction > 3;
+		if(is_wait && m_length >= NUM_WAIT_STEPS) continue;
+		if(is_wait) m_waitMask |= 1u << m_length;
+
+		const int word_idx = m_length / STEPS_PER_WORD;
+		const int shift = (m_length % STEPS_PER_WORD) * 2;
+		const uint bits = is_wait ? 0u : static_cast<uint>(direction);
+		m_steps[word_idx] = (m_steps[word_idx] & ~(3u << shift)) | (bits << shift);
+		++m_length;
+	}
+}
+
+
+//--------------------------------------------------------------------------
+// accessors
+
+
+//anything past the end is a hold
+eOrderCode PackedPath::GetOrder(const int step) const
+{
+	if(step < 0 || step >= m_length) return ORDER_HOLD;
+	if(step < NUM_WAIT_STEPS && (m_waitMask & (1u << step)) != 0) return ORDER_HOLD;
+
+	const uint bits = (m_steps[step / STEPS_PER_WORD] >> ((step % STEPS_PER_WORD) * 2)) & 3u;
+	return static_cast<eOrderCode>(ORDER_MOVE_EAST + bits);
+}
+
+
+int PackedPath::GetLength() const
+{
+	return m_length;
+}
+
+
+//writes up to max_orders steps starting at first_step, returns how many were written
+int PackedPath::Unpack(eOrderCode* out_orders, const int first_step, const int max_orders) const
+{
+	int num_written = 0;
+	for(int step = first_step; step < m_length && num_written < max_orders; ++step)
+	{
+		out_orders[num_written] = GetOrder(step);
+		++num_written;
+	}
+
+	return num_written;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "Blackboard.hpp"
+#include <vector>
+
+//a route at two bits a step, each step keeps its direction from ORDER_MOVE_EAST.
+//Every ant owns one fixed slot of MAX_PATH steps, so nothing is allocated and reading
+//a step is a shift and a mask. Waits only come from the cooperative weave near the
+//front of a route, they are flagged in a small mask instead of widening every step
+class PackedPath
+{
+public:
+	PackedPath() = default;
+	~PackedPath() = default;
+
+	//mutators
+	void		Clear();
+	void		Assign(const std::vector<eOrderCode>& orders);
+
+	//accessors
+	eOrderCode	GetOrder(int step) const;
+	int			GetLength() const;
+	int			Unpack(eOrderCode* out_orders, int first_step, int max_orders) const;
+
+private:
+	static constexpr int STEPS_PER_WORD = 16;
+	static constexpr int NUM_STEP_WORDS = (MAX_PATH + STEPS_PER_WORD - 1) / STEPS_PER_WORD;
+	static constexpr int NUM_WAIT_STEPS = 32;
+
+	uint	m_steps[NUM_STEP_WORDS] = { 0 };
+	uint	m_waitMask = 0;		//bit n set, step n is ORDER_HOLD
+	int		m_length = 0;
+};
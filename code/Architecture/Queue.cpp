@@ -1,5 +1,6 @@
 #include "Architecture/Queue.hpp"
 #include "Architecture/FifoIterator.hpp"
+#include "Architecture/BucketIterator.hpp"
 
 void Queue::Clear()
 {
@@ -18,4 +19,9 @@ QueueIterator* Queue::CreateFifoIterator() const
 	return nullptr;
 }
 
+QueueIterator* Queue::CreateBucketIterator() const
+{
+	return new BucketIterator();
+}
+
 
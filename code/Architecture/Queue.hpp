@@ -16,6 +16,7 @@ public:
 	QueueIterator* CreateFifoIterator() const;
 	//QueueIterator* CreateLifoIterator();
 	//QueueIterator* CreatePriorityIterator();
+	QueueIterator* CreateBucketIterator() const;
 
 private:
 	std::list<short>	m_list;
@@ -5,9 +5,13 @@
 class QueueIterator
 {
 public:
-	virtual void Push(short el) = 0;
+	virtual ~QueueIterator() = default;
+
+	virtual void Push(int el) = 0;
 	virtual void Pop() = 0;
-	virtual short Peak() = 0;
+	virtual int Peak() = 0;
 
+	//only ordered queues use the priority, the rest push as normal
+	virtual void PushWithPriority(int el, int /*priority*/) { Push(el); }
 	
 };
\ No newline at end of file
@@ -6,9 +6,11 @@
 RandomNumberGenerator g_randomNumberGenerator(15);
 
 MatchInfo					g_matchInfo;
+PlayerInfo					g_playerInfo;
+double						g_maxTurnSeconds = 0.0;
 DebugInterface*				g_debugInterface = nullptr;
 ArenaTurnStateForPlayer		g_turnState;
-MinHeap<RepathPriority>		g_pathingRequests(MIN_NUM_WORKERS + MAX_NUM_SOLDIERS + 1);
+IndexedMinHeap<RepathPriority>	g_pathingRequests(MAX_AGENTS_PER_PLAYER, MAX_AGENTS_PER_PLAYER);
 
 int			g_currentNumScouts = 0;
 int			g_currentNumWorkers = 0;
@@ -63,6 +63,8 @@ public:
 
 // Global variables that everyone can share
 extern MatchInfo				g_matchInfo;
+extern PlayerInfo				g_playerInfo;
+extern double					g_maxTurnSeconds;
 extern DebugInterface*			g_debugInterface;
 extern ArenaTurnStateForPlayer	g_turnState;
 extern RandomNumberGenerator	g_randomNumberGenerator;
@@ -75,7 +77,7 @@ extern int g_currentNumSoldier;
 extern int g_currentNumQueen;
 extern int g_numRepaths;
 extern IntVec2 g_queenPos;
-extern MinHeap<RepathPriority> g_pathingRequests;
+extern IndexedMinHeap<RepathPriority> g_pathingRequests; //keyed by AntPool slot
 
 
 constexpr int MIN_NUM_WORKERS = 70;
@@ -88,9 +90,8 @@ constexpr int CONSERVE_WORKERS_AT = 150;
 constexpr int MAX_CONTAINER_SIZE = 65'536;
 //constexpr int MAX_TREE_DEPTH = 50;
 //constexpr int MAX_PATH = MAX_TREE_DEPTH*MAX_TREE_DEPTH + (MAX_TREE_DEPTH + 1)*(MAX_TREE_DEPTH+1);
-constexpr int MAX_PATH = 32;
+constexpr int MAX_PATH = 512;	//steps an ant can hold, packed at two bits a step
 constexpr float MAX_PATH_INVERSE = 1.0f / MAX_PATH;
-constexpr eOrderCode DEFAULT_PATHING[MAX_PATH] = { ORDER_HOLD };
 constexpr int MAX_REPATHING = 8;
 
 enum JobCategory
@@ -110,8 +111,42 @@ enum eQueueType
 
 	QUEUE_FIFO,
 	QUEUE_LIFO,
-	QUEUE_PRIORITY,
+	QUEUE_PRIORITY,	//binary heap, any float priority
+	QUEUE_BUCKET,	//Dial's buckets, small integer priorities
 
 	NUM_QUEUE_TYPES
 };
 
+enum eCarryState
+{
+	UNKNOWN_CARRY_STATE = -1,
+
+	CARRY_NOTHING,
+	CARRY_FOOD,
+	CARRY_TILE,
+
+	NUM_CARRY_STATES
+};
+
+enum ePathingStrategy
+{
+	UNKNOWN_PATHING_STRATEGY = -1,
+
+	PATHING_ASTAR,
+	PATHING_JUMP_POINT,	//jumps across open air, steps through dirt and water like A*
+	PATHING_HIERARCHICAL,	//HPA*, searches cluster entrances then refines inside each cluster
+	PATHING_INCREMENTAL,	//D* Lite kept per ant, only repairs what changed since its last plan
+	PATHING_BIDIRECTIONAL,	//A* from both ends at once, stops once neither side can beat where they met
+	PATHING_ANYTIME,	//A* kept per ant on a budget, walks toward the closest tile until the goal is reached
+
+	NUM_PATHING_STRATEGIES
+};
+
+constexpr ePathingStrategy ANT_PATHING_STRATEGY = PATHING_INCREMENTAL;
+constexpr int MAX_INCREMENTAL_EXPANSIONS = 1024;	//per replan, an unfinished search carries on next turn
+constexpr int MAX_INCREMENTAL_NODES = 16'384;		//a planner that has touched more tiles starts over
+constexpr int MAX_ANYTIME_EXPANSIONS = 512;			//per call, the search carries on next turn
+constexpr int MAX_ANYTIME_NODES = 16'384;			//a search that has touched more tiles starts over
+constexpr double ANYTIME_TURN_SHARE = 0.02;			//of maxTurnSeconds, the most one ant's search may take
+constexpr bool ANT_COOPERATIVE_PATHING = true;		//weave each new plan around the ones already made this turn
+
@@ -9,10 +9,17 @@
 AntUnit::AntUnit() {}
 AntUnit::~AntUnit() {}
 
-void AntUnit::Init(AgentReport& report)
+void AntUnit::Init(AgentReport& report, const int pool_idx)
 {
 	m_report = report;
+	m_poolIdx = pool_idx;
 	m_currentCoord = IntVec2(report.tileX, report.tileY);
+	m_path.Clear();
+	m_currentOrderIndex = 0;
+	m_pathGoal = IntVec2::NEG_ONE;
+	m_expectedCoord = m_currentCoord;
+	m_planner.Reset();
+	m_anytimeSearch.Reset();
 	m_isGarbage = false;
 }
 
@@ -126,10 +133,18 @@ void AntUnit::UpdateWorker()
 		}
 		else
 		{
-			//we need to hall ass to the queen
+			//we need to hall ass to the queen, the colony field already knows the way
 			m_goalCoord = g_queenPos;
-			float priority = 1.0f - (m_currentOrderIndex * MAX_PATH_INVERSE);
-			g_pathingRequests.Push(RepathPriority(m_report.agentID, priority));
+			const eOrderCode order = Geographer::GetOrderTowardQueen(m_currentCoord);
+			if(order != ORDER_HOLD)
+			{
+				MainThread::GetInstance()->AddOrder(m_report.agentID, order);
+			}
+			else
+			{
+				float priority = 1.0f - (m_currentOrderIndex * MAX_PATH_INVERSE);
+				g_pathingRequests.Push(m_poolIdx, RepathPriority(m_report.agentID, priority));
+			}
 			
 			//std::vector<eOrderCode> pathing = Geographer::PathfindAstar(m_currentCoord, g_queenPos);
 			//MainThread::GetInstance()->AddOrder(m_report.agentID, pathing.front());
@@ -139,7 +154,7 @@ void AntUnit::UpdateWorker()
 	{
 		if(m_goalCoord == IntVec2::NEG_ONE)
 		{
-			IntVec2 coord_to_go_to = Geographer::AddAntToFoodTile(m_report.agentID);
+			IntVec2 coord_to_go_to = Geographer::AddAntToFoodTile(m_report.agentID, m_currentCoord);
 
 			//if there is no work
 			if(coord_to_go_to == IntVec2(-1, -1))
@@ -150,7 +165,7 @@ void AntUnit::UpdateWorker()
 			{		
 				m_goalCoord = coord_to_go_to;
 				float priority = 1.0f - (m_currentOrderIndex * MAX_PATH_INVERSE);
-				g_pathingRequests.Push(RepathPriority(m_report.agentID, priority));
+				g_pathingRequests.Push(m_poolIdx, RepathPriority(m_report.agentID, priority));
 
 				//std::vector<eOrderCode> pathing = Geographer::PathfindAstar(m_currentCoord, coord_to_go_to);
 				//MainThread::GetInstance()->AddOrder(m_report.agentID, pathing.front());
@@ -179,7 +194,7 @@ void AntUnit::UpdateWorker()
 			{
 				// m_goalCoord = coord_to_go_to;
 				float priority = 1.0f - (m_currentOrderIndex * MAX_PATH_INVERSE);
-				g_pathingRequests.Push(RepathPriority(m_report.agentID, priority));
+				g_pathingRequests.Push(m_poolIdx, RepathPriority(m_report.agentID, priority));
 
 				//std::vector<eOrderCode> pathing = Geographer::PathfindAstar(m_currentCoord, m_goalCoord);
 				//MainThread::GetInstance()->AddOrder(m_report.agentID, pathing.front());
@@ -198,13 +213,13 @@ void AntUnit::UpdateSoldier()
 
 	if(Geographer::HowManyEnemiesCanISee() > 0)
 	{
-		IntVec2 enemy_coord = Geographer::GetNextEnemyCoord();
+		IntVec2 enemy_coord = Geographer::GetNearestEnemyCoord(m_currentCoord);
 
 		if(enemy_coord != IntVec2::NEG_ONE)
 		{
 			float priority = 0.1f;
 			m_goalCoord = enemy_coord;
-			g_pathingRequests.Push(RepathPriority(m_report.agentID, priority));
+			g_pathingRequests.Push(m_poolIdx, RepathPriority(m_report.agentID, priority));
 		}
 
 	}
@@ -218,8 +233,6 @@ void AntUnit::UpdateQueen()
 	}
 
 	g_queenPos = IntVec2(m_report.tileX, m_report.tileY);
-	Geographer::UpdateListOfFood(g_queenPos);
-
 
 	if(g_currentNumSoldier < g_turnState.numObservedAgents && g_currentNumSoldier < MAX_NUM_SOLDIERS)
 	{
@@ -253,30 +266,103 @@ void AntUnit::MoveGreedy(const IntVec2& start, const IntVec2& goal)
 }
 
 void AntUnit::UpdatePath()
+{
+	ApplyPath(PlanPath());
+}
+
+//only touches this ant and reads the map, so the turn's batch can plan ants on any thread
+std::vector<eOrderCode> AntUnit::PlanPath()
+{
+	const bool for_worker = m_report.type == AGENT_TYPE_WORKER;
+	const eCarryState carry_state = GetCarryState();
+	if(ANT_PATHING_STRATEGY == PATHING_INCREMENTAL)
+		return m_planner.Replan(m_currentCoord, m_goalCoord, for_worker, carry_state);
+
+	if(ANT_PATHING_STRATEGY == PATHING_ANYTIME)
+		return m_anytimeSearch.Resume(m_currentCoord, m_goalCoord, for_worker, MAX_ANYTIME_EXPANSIONS,
+			g_maxTurnSeconds * ANYTIME_TURN_SHARE, carry_state);
+
+	//the shared searches only know the empty handed tables, a carrier gets a plain A* on its own
+	if(carry_state != CARRY_NOTHING)
+		return Geographer::PathfindAstar(m_currentCoord, m_goalCoord, m_report.type, carry_state);
+
+	return Geographer::Pathfind(m_currentCoord, m_goalCoord, for_worker);
+}
+
+//weaving around reservations depends on who went first, so this runs in request order
+void AntUnit::ApplyPath(const std::vector<eOrderCode>& planned_path)
 {
 	m_currentOrderIndex = 0;
-	memcpy(&m_pathOrders, &DEFAULT_PATHING, sizeof(eOrderCode)*MAX_PATH );
+	m_pathGoal = m_goalCoord;
+	m_expectedCoord = m_currentCoord;
 	
-	std::vector<eOrderCode> pathing;
-	if(m_report.type == AGENT_TYPE_WORKER)
-		pathing = Geographer::PathfindAstar(m_currentCoord, m_goalCoord, true);
-	else
-		pathing = Geographer::PathfindAstar(m_currentCoord, m_goalCoord, false);
+	const bool for_worker = m_report.type == AGENT_TYPE_WORKER;
+	std::vector<eOrderCode> pathing = planned_path;
+	if(ANT_COOPERATIVE_PATHING)
+		pathing = Geographer::PathfindCooperative(m_currentCoord, pathing, for_worker, GetCarryState());
 
-	int max_num = Min(pathing.size(), MAX_PATH);
-	
-	for(int idx = 0; idx < max_num; ++idx)
-	{
-		m_pathOrders[idx] = pathing[idx];
-	}	
+	m_path.Assign(pathing);
 }
 
 void AntUnit::ContinuePath()
 {
-	ASSERT_OR_DIE(m_currentOrderIndex < MAX_PATH, "Reading outside of max path")
+	ASSERT_OR_DIE(m_currentOrderIndex <= m_path.GetLength(), "Reading outside of the stored path")
+
+	//whoever plans after us this turn steps around the tiles we are about to walk
+	if(ANT_COOPERATIVE_PATHING)
+	{
+		eOrderCode upcoming_orders[RESERVATION_WINDOW];
+		const int num_upcoming = m_path.Unpack(upcoming_orders, m_currentOrderIndex, RESERVATION_WINDOW);
+		Geographer::ReservePath(m_currentCoord, upcoming_orders, num_upcoming);
+	}
 	
-	MainThread::GetInstance()->AddOrder(m_report.agentID, m_pathOrders[m_currentOrderIndex]);
-	++m_currentOrderIndex;
+	//a step into dirt goes out as a dig first, the step itself is taken once the tile is open
+	const eOrderCode path_order = m_path.GetOrder(m_currentOrderIndex);
+	const eOrderCode order = Geographer::GetStepOrder(m_currentCoord, path_order, m_report.type, GetCarryState());
+	MainThread::GetInstance()->AddOrder(m_report.agentID, order);
+	if(order != path_order)
+	{
+		m_expectedCoord = m_currentCoord;
+		return;
+	}
+
+	m_expectedCoord = Geographer::GetCoordFromCardDir(order, m_currentCoord);
+	if(m_currentOrderIndex < m_path.GetLength()) ++m_currentOrderIndex;
+}
+
+eCarryState AntUnit::GetCarryState() const
+{
+	if(m_report.state == STATE_HOLDING_FOOD) return CARRY_FOOD;
+	if(m_report.state == STATE_HOLDING_DIRT) return CARRY_TILE;
+	return CARRY_NOTHING;
+}
+
+//a stored path is walked until it runs out, the goal moves, a move did not land where it
+//should have, or a tile still ahead can no longer be walked with what the ant is carrying,
+//so a long haul is planned once. A next step the ant would have to hold on, like a carrier
+//facing dirt, needs a new path too or the ant would wait there for good
+bool AntUnit::NeedsPath() const
+{
+	if(m_currentOrderIndex >= m_path.GetLength()) return true;
+	if(m_pathGoal != m_goalCoord || m_currentCoord != m_expectedCoord) return true;
+
+	const eCarryState carry_state = GetCarryState();
+	const eOrderCode next_order = m_path.GetOrder(m_currentOrderIndex);
+	if(next_order != ORDER_HOLD &&
+		Geographer::GetStepOrder(m_currentCoord, next_order, m_report.type, carry_state) == ORDER_HOLD)
+		return true;
+
+	const eAgentType cost_type = m_report.type == AGENT_TYPE_WORKER ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	IntVec2 coord = m_currentCoord;
+	for(int step = m_currentOrderIndex; step < m_path.GetLength(); ++step)
+	{
+		coord = Geographer::GetCoordFromCardDir(m_path.GetOrder(step), coord);
+		if(!Geographer::IsValidCoord(coord) ||
+			!Geographer::IsWalkableTile(Geographer::GetTileIndex(coord), cost_type, carry_state))
+			return true;
+	}
+
+	return false;
 }
 
 bool AntUnit::InUse() const
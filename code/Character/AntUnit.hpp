@@ -2,6 +2,9 @@
 #include "Arena/ArenaPlayerInterface.hpp"
 #include "Math/IntVec2.hpp"
 #include "Blackboard.hpp"
+#include "Geographer/DStarLite.hpp"
+#include "Geographer/AnytimeSearch.hpp"
+#include "Architecture/PackedPath.hpp"
 
 struct IntVec2;
 struct ArenaTurnStateForPlayer;
@@ -25,10 +28,14 @@ public:
 	void MoveRandom( );
 	void MoveGreedy( const IntVec2& start, const IntVec2& goal );
 	void UpdatePath();
+	std::vector<eOrderCode> PlanPath();
+	void ApplyPath( const std::vector<eOrderCode>& planned_path );
 	void ContinuePath();
+	bool NeedsPath() const;
+	eCarryState GetCarryState() const;
 	
 	// Obj Pool
-	void Init(AgentReport& report);
+	void Init(AgentReport& report, int pool_idx);
 	bool InUse() const;
 
 private:
@@ -37,9 +44,14 @@ private:
 	
 	//helper functions
 	IntVec2			m_goalCoord = IntVec2::NEG_ONE;
-	eOrderCode		m_pathOrders[MAX_PATH] = { ORDER_HOLD };
+	PackedPath		m_path;
 	int				m_currentOrderIndex = 0;
+	IntVec2			m_pathGoal = IntVec2::NEG_ONE;		//goal the stored path was planned for
+	IntVec2			m_expectedCoord = IntVec2::NEG_ONE;	//where the last order should have left us
+	DStarLite		m_planner;	//kept across turns so a repath only repairs what changed
+	AnytimeSearch	m_anytimeSearch;	//kept across turns so a long search finishes over several
 	
 	// used for obj pooling
 	bool			m_isGarbage = true;
+	int				m_poolIdx = -1;
 };
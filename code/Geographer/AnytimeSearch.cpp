@@ -0,0 +1,234 @@
+#include "Geographer/AnytimeSearch.hpp"
+#include "Geographer/Geographer.hpp"
+#include <algorithm>
+#include <functional>
+
+//reading the clock every expansion would cost more than the expansion itself
+constexpr int CLOCK_CHECK_MASK = 63;
+
+
+//--------------------------------------------------------------------------
+// searching
+
+
+//drops every tile the search has touched, the next call starts from nothing
+void AnytimeSearch::Reset()
+{
+	m_nodes = std::unordered_map<int, SearchNode>();
+	m_openList = std::vector<SearchEntry>();
+	m_changedTiles.clear();
+	m_rootIdx = -1;
+	m_goalIdx = -1;
+	m_bestIdx = -1;
+	m_isFinished = false;
+	m_changeCursor = -1;
+	m_numExpansions = 0;
+}
+
+
+//the tree keeps growing from the tile the search started on, as long as the ant is still
+//standing on it and nothing it touched has changed. Once the goal is reached the route is
+//only read back out, an ant that wandered off the tree gets a new search from where it stands
+std::vector<eOrderCode> AnytimeSearch::Resume(const IntVec2& start, const IntVec2& goal, const bool for_worker,
+	const int max_expansions, const double max_seconds, const eCarryState carry_state)
+{
+	std::vector<eOrderCode> order_list;
+	if(start == goal || !Geographer::IsReachable(start, goal, for_worker))
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	const auto deadline = std::chrono::steady_clock::now() +
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(max_seconds));
+
+	const int start_idx = Geographer::GetTileIndex(start);
+	const int goal_idx = Geographer::GetTileIndex(goal);
+
+	if(!IsStillValid(start_idx, goal_idx, for_worker, carry_state))
+	{
+		Restart(start_idx, goal_idx, for_worker, carry_state);
+	}
+
+	m_numExpansions = 0;
+	Expand(max_expansions, deadline);
+
+	//the closest tile moved onto a branch the ant is not on, grow a tree from the ant instead
+	if(!ExtractPath(order_list, start_idx))
+	{
+		Restart(start_idx, goal_idx, for_worker, carry_state);
+		Expand(max_expansions, deadline);
+		ExtractPath(order_list, start_idx);
+	}
+
+	if(order_list.empty())
+	{
+		order_list.push_back(ORDER_HOLD);
+	}
+
+	return order_list;
+}
+
+
+//true once the goal is reached or there is nothing left that could reach it
+bool AnytimeSearch::IsFinished() const
+{
+	return m_isFinished;
+}
+
+
+int AnytimeSearch::GetNumExpansions() const
+{
+	return m_numExpansions;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+void AnytimeSearch::Restart(const int start_index, const int goal_index, const bool for_worker,
+	const eCarryState carry_state)
+{
+	m_nodes.clear();
+	m_openList.clear();
+	m_rootIdx = start_index;
+	m_goalIdx = goal_index;
+	m_bestIdx = -1;
+	m_forWorker = for_worker;
+	m_carryState = carry_state;
+	m_isFinished = false;
+	m_changeCursor = Geographer::GetChangedTileCursor();
+
+	SearchNode& root_node = m_nodes[start_index];
+	root_node.m_pathCost = 0.0f;
+	m_openList.push_back({start_index, 0.0f, Heuristic(start_index)});
+}
+
+
+//a changed tile only matters when the search has stepped on it or next to it, anything
+//further out is read fresh when the search gets there
+bool AnytimeSearch::IsStillValid(const int start_index, const int goal_index, const bool for_worker,
+	const eCarryState carry_state)
+{
+	if(goal_index != m_goalIdx || for_worker != m_forWorker || carry_state != m_carryState) return false;
+	if(static_cast<int>(m_nodes.size()) > MAX_ANYTIME_NODES) return false;
+
+	const auto start_iter = m_nodes.find(start_index);
+	if(start_iter == m_nodes.end() || !start_iter->second.m_isClosed) return false;
+
+	m_changedTiles.clear();
+	if(!Geographer::GetTilesChangedSince(m_changeCursor, m_changedTiles)) return false;
+
+	for(const int tile_idx : m_changedTiles)
+	{
+		if(m_nodes.find(tile_idx) != m_nodes.end()) return false;
+
+		for(NeighborIterator neighbor(tile_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			if(m_nodes.find(neighbor.GetTileIndex()) != m_nodes.end()) return false;
+		}
+	}
+
+	return true;
+}
+
+
+void AnytimeSearch::Expand(const int max_expansions, const std::chrono::steady_clock::time_point& deadline)
+{
+	if(m_isFinished) return;
+
+	while(m_numExpansions < max_expansions && !m_openList.empty())
+	{
+		if((m_numExpansions & CLOCK_CHECK_MASK) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+
+		std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<SearchEntry>());
+		const SearchEntry top = m_openList.back();
+		m_openList.pop_back();
+
+		SearchNode& node = m_nodes[top.m_idx];
+		if(node.m_isClosed || top.m_pathCost != node.m_pathCost) continue;
+
+		node.m_isClosed = true;
+		++m_numExpansions;
+
+		const float heuristic = Heuristic(top.m_idx);
+		if(m_bestIdx == -1 || heuristic < Heuristic(m_bestIdx) ||
+			(heuristic == Heuristic(m_bestIdx) && node.m_pathCost < m_nodes[m_bestIdx].m_pathCost))
+		{
+			m_bestIdx = top.m_idx;
+		}
+
+		if(top.m_idx == m_goalIdx)
+		{
+			m_isFinished = true;
+			return;
+		}
+
+		for(NeighborIterator neighbor(top.m_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int neighbor_idx = neighbor.GetTileIndex();
+			const float step_cost = GetStepCost(neighbor_idx);
+			if(step_cost == FLT_MAX) continue;
+
+			const float new_cost = node.m_pathCost + step_cost;
+			SearchNode& neighbor_node = m_nodes[neighbor_idx];
+			if(neighbor_node.m_isClosed || neighbor_node.m_pathCost <= new_cost) continue;
+
+			neighbor_node.m_pathCost = new_cost;
+			neighbor_node.m_parentIdx = top.m_idx;
+			neighbor_node.m_actionTook = neighbor.GetMoveOrder();
+
+			m_openList.push_back({neighbor_idx, new_cost, new_cost + Heuristic(neighbor_idx)});
+			std::push_heap(m_openList.begin(), m_openList.end(), std::greater<SearchEntry>());
+		}
+	}
+
+	//nothing queued and no goal, the closest tile is as good as it will get
+	if(m_openList.empty()) m_isFinished = true;
+}
+
+
+//walks back from the closest tile, fails when from_index is not on that branch of the tree
+bool AnytimeSearch::ExtractPath(std::vector<eOrderCode>& out_orders, const int from_index) const
+{
+	out_orders.clear();
+
+	int current_idx = m_bestIdx;
+	while(current_idx != from_index)
+	{
+		if(current_idx == -1)
+		{
+			out_orders.clear();
+			return false;
+		}
+
+		const SearchNode& node = m_nodes.at(current_idx);
+		out_orders.push_back(node.m_actionTook);
+		current_idx = node.m_parentIdx;
+	}
+
+	std::reverse(out_orders.begin(), out_orders.end());
+	if(out_orders.size() > MAX_PATH) out_orders.resize(MAX_PATH);
+	return true;
+}
+
+
+//same costs as D* Lite, one per step plus the tile's exhaust. The goal itself is always
+//enterable, an ant heading for the queen still needs a route up to her
+float AnytimeSearch::GetStepCost(const int to_index) const
+{
+	const eAgentType agent_type = m_forWorker ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	const bool is_walkable = Geographer::IsWalkableTile(to_index, agent_type, m_carryState);
+	if(to_index == m_goalIdx && !is_walkable) return 1.0f;
+	if(!is_walkable) return FLT_MAX;
+	return 1.0f + Geographer::GetExhaustPenalty(Geographer::s_perceivedTypes[to_index], agent_type, m_carryState);
+}
+
+
+//every step costs at least one, so the landmark bound never overestimates. A tighter
+//bound also makes the closest tile a better guess at where the route really goes
+float AnytimeSearch::Heuristic(const int tile_index) const
+{
+	return Geographer::LandmarkHeuristic(tile_index, m_goalIdx);
+}
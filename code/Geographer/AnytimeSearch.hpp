@@ -0,0 +1,66 @@
+#pragma once
+#include "Blackboard.hpp"
+#include "Math/IntVec2.hpp"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+//A* for one ant that can stop at any point and pick up where it left off on a later turn.
+//Each call spends at most its expansion and time budget, and when the goal is still out of
+//reach the ant is handed the route to the tile that got closest, so a long query moves the
+//ant every turn instead of holding until one search can finish it
+class AnytimeSearch
+{
+	struct SearchNode
+	{
+		float		m_pathCost = FLT_MAX;
+		int			m_parentIdx = -1;
+		eOrderCode	m_actionTook = ORDER_HOLD;
+		bool		m_isClosed = false;
+	};
+
+	//the open list is never searched, a cheaper route to a tile leaves the old entry behind
+	//and entries that no longer match their node are dropped when they reach the top
+	struct SearchEntry
+	{
+		int		m_idx = -1;
+		float	m_pathCost = FLT_MAX;
+		float	m_priority = FLT_MAX;
+
+		friend bool operator>(const SearchEntry& lhs, const SearchEntry& rhs)
+		{
+			return lhs.m_priority > rhs.m_priority;
+		}
+	};
+
+public:
+	AnytimeSearch() = default;
+	~AnytimeSearch() = default;
+
+	void					Reset();
+	std::vector<eOrderCode>	Resume( const IntVec2& start, const IntVec2& goal, bool for_worker,
+								int max_expansions, double max_seconds, eCarryState carry_state = CARRY_NOTHING );
+	bool					IsFinished() const;
+	int						GetNumExpansions() const;
+
+private:
+	void				Restart( int start_index, int goal_index, bool for_worker, eCarryState carry_state );
+	bool				IsStillValid( int start_index, int goal_index, bool for_worker, eCarryState carry_state );
+	void				Expand( int max_expansions, const std::chrono::steady_clock::time_point& deadline );
+	bool				ExtractPath( std::vector<eOrderCode>& out_orders, int from_index ) const;
+	float				GetStepCost( int to_index ) const;
+	float				Heuristic( int tile_index ) const;
+
+private:
+	std::unordered_map<int, SearchNode>	m_nodes;
+	std::vector<SearchEntry>			m_openList;
+	std::vector<int>					m_changedTiles;
+	int		m_rootIdx = -1;
+	int		m_goalIdx = -1;
+	int		m_bestIdx = -1;		//closed tile with the lowest heuristic, the goal once it is reached
+	bool	m_forWorker = true;
+	eCarryState	m_carryState = CARRY_NOTHING;	//a carrier can not dig, so it walks its own cost table
+	bool	m_isFinished = false;
+	int		m_changeCursor = -1;
+	int		m_numExpansions = 0;
+};
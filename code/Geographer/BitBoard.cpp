@@ -0,0 +1,317 @@
+#include "Geographer/BitBoard.hpp"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+//--------------------------------------------------------------------------
+// mutators
+
+
+void BitBoard::Clear()
+{
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		m_words[word_idx] = 0;
+	}
+}
+
+
+//every tile of a width by width map
+void BitBoard::Fill(const int width)
+{
+	Clear();
+	for(int row = 0; row < width; ++row)
+	{
+		for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+		{
+			const int first_x = word_num * WORD_BITS;
+			const int num_bits = width - first_x;
+			if(num_bits <= 0) break;
+
+			m_words[row * WORDS_PER_ROW + word_num] = num_bits >= WORD_BITS ? ~0ull : (1ull << num_bits) - 1;
+		}
+	}
+}
+
+
+void BitBoard::Set(const IntVec2& coord)
+{
+	m_words[coord.y * WORDS_PER_ROW + coord.x / WORD_BITS] |= 1ull << (coord.x % WORD_BITS);
+}
+
+
+//every x from min_x to max_x on one row, a word at a time
+void BitBoard::SetSpan(const int row, const int min_x, const int max_x)
+{
+	unsigned long long* row_words = &m_words[row * WORDS_PER_ROW];
+	for(int word_num = min_x / WORD_BITS; word_num <= max_x / WORD_BITS; ++word_num)
+	{
+		const int first_bit = min_x > word_num * WORD_BITS ? min_x - word_num * WORD_BITS : 0;
+		const int last_bit = max_x < (word_num + 1) * WORD_BITS ? max_x - word_num * WORD_BITS : WORD_BITS - 1;
+		const unsigned long long low_mask = last_bit == WORD_BITS - 1 ? ~0ull : (1ull << (last_bit + 1)) - 1;
+		row_words[word_num] |= low_mask & (~0ull << first_bit);
+	}
+}
+
+
+void BitBoard::Reset(const IntVec2& coord)
+{
+	m_words[coord.y * WORDS_PER_ROW + coord.x / WORD_BITS] &= ~(1ull << (coord.x % WORD_BITS));
+}
+
+
+void BitBoard::Or(const BitBoard& other)
+{
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		m_words[word_idx] |= other.m_words[word_idx];
+	}
+}
+
+
+//only the rows asked for, a layer from Expand is undefined outside the rows it reports
+void BitBoard::OrRows(const BitBoard& other, const int min_row, const int max_row)
+{
+	for(int word_idx = min_row * WORDS_PER_ROW; word_idx < (max_row + 1) * WORDS_PER_ROW; ++word_idx)
+	{
+		m_words[word_idx] |= other.m_words[word_idx];
+	}
+}
+
+
+void BitBoard::And(const BitBoard& other)
+{
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		m_words[word_idx] &= other.m_words[word_idx];
+	}
+}
+
+
+void BitBoard::AndNot(const BitBoard& other)
+{
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		m_words[word_idx] &= ~other.m_words[word_idx];
+	}
+}
+
+
+//--------------------------------------------------------------------------
+// accessors
+
+
+bool BitBoard::Test(const IntVec2& coord) const
+{
+	return (m_words[coord.y * WORDS_PER_ROW + coord.x / WORD_BITS] >> (coord.x % WORD_BITS)) & 1ull;
+}
+
+
+bool BitBoard::IsEmpty() const
+{
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		if(m_words[word_idx] != 0) return false;
+	}
+
+	return true;
+}
+
+
+int BitBoard::Count() const
+{
+	int count = 0;
+	for(int word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+	{
+		unsigned long long word = m_words[word_idx];
+		while(word != 0)
+		{
+			word &= word - 1;
+			++count;
+		}
+	}
+
+	return count;
+}
+
+
+//--------------------------------------------------------------------------
+// kernels
+
+
+//out_next is every passable tile beside the frontier that is not reached yet. Only the rows
+//the frontier covers, plus one either side, are written, and the range comes back as the
+//rows out_next covers. Rows outside it keep whatever they held. Returns false once nothing
+//new was found
+bool BitBoard::Expand(const BitBoard& frontier, const BitBoard& passable, const BitBoard& reached,
+	BitBoard& out_next, int& in_out_min_row, int& in_out_max_row)
+{
+	const int min_row = in_out_min_row > 0 ? in_out_min_row - 1 : 0;
+	const int max_row = in_out_max_row < NUM_ROWS - 1 ? in_out_max_row + 1 : NUM_ROWS - 1;
+
+	//rows of the frontier outside its range are never read, they may hold an older layer
+	static constexpr unsigned long long EMPTY_ROW[WORDS_PER_ROW] = { 0 };
+	const auto get_frontier_row = [&](const int row) -> const unsigned long long*
+	{
+		if(row < in_out_min_row || row > in_out_max_row) return EMPTY_ROW;
+		return &frontier.m_words[row * WORDS_PER_ROW];
+	};
+
+	int new_min_row = NUM_ROWS;
+	int new_max_row = -1;
+	for(int row = min_row; row <= max_row; ++row)
+	{
+		const unsigned long long* here = get_frontier_row(row);
+		const unsigned long long* below = get_frontier_row(row - 1);
+		const unsigned long long* above = get_frontier_row(row + 1);
+
+		unsigned long long row_bits = 0;
+		for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+		{
+			const int word_idx = row * WORDS_PER_ROW + word_num;
+
+			//from the west neighbor moving east, and from the east neighbor moving west
+			unsigned long long spread = (here[word_num] << 1) | (here[word_num] >> 1) | below[word_num] | above[word_num];
+			if(word_num > 0)					spread |= here[word_num - 1] >> (WORD_BITS - 1);
+			if(word_num < WORDS_PER_ROW - 1)	spread |= here[word_num + 1] << (WORD_BITS - 1);
+
+			const unsigned long long next = spread & passable.m_words[word_idx] & ~reached.m_words[word_idx];
+			out_next.m_words[word_idx] = next;
+			row_bits |= next;
+		}
+
+		if(row_bits != 0)
+		{
+			if(row < new_min_row) new_min_row = row;
+			new_max_row = row;
+		}
+	}
+
+	in_out_min_row = new_min_row;
+	in_out_max_row = new_max_row;
+	return new_max_row >= 0;
+}
+
+
+//grows in_out_reached over passable until nothing new joins. The reached tiles themselves
+//do not have to be passable, so a seed standing on a wall still spreads to its neighbors.
+//Rows are swept up then down, each row filling every passable run it touches end to end and
+//handing the result to the next row in the same sweep, so a pass covers whole corridors
+void BitBoard::FloodFill(BitBoard& in_out_reached, const BitBoard& passable)
+{
+	//rows past the map are empty, a small map only sweeps its own rows
+	int num_rows = NUM_ROWS;
+	while(num_rows > 0 && in_out_reached.IsRowEmpty(num_rows - 1) && passable.IsRowEmpty(num_rows - 1))
+	{
+		--num_rows;
+	}
+
+	bool has_changed = true;
+	while(has_changed)
+	{
+		has_changed = false;
+		for(int row = 0; row < num_rows; ++row)
+		{
+			has_changed |= FillRow(in_out_reached, passable, row, row - 1);
+		}
+
+		for(int row = num_rows - 1; row >= 0; --row)
+		{
+			has_changed |= FillRow(in_out_reached, passable, row, row + 1);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+int BitBoard::LowestBit(const unsigned long long word)
+{
+#ifdef _MSC_VER
+	unsigned long bit_idx = 0;
+	_BitScanForward64(&bit_idx, word);
+	return static_cast<int>(bit_idx);
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+
+bool BitBoard::IsRowEmpty(const int row) const
+{
+	for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+	{
+		if(m_words[row * WORDS_PER_ROW + word_num] != 0) return false;
+	}
+
+	return true;
+}
+
+
+//pulls in the passable tiles beside the row it came from, then runs every reached bit along
+//its passable run in both directions. Returns true when the row gained a tile
+bool BitBoard::FillRow(BitBoard& in_out_reached, const BitBoard& passable, const int row, const int from_row)
+{
+	unsigned long long* reached = &in_out_reached.m_words[row * WORDS_PER_ROW];
+	const unsigned long long* open = &passable.m_words[row * WORDS_PER_ROW];
+	const bool has_from_row = from_row >= 0 && from_row < NUM_ROWS;
+
+	unsigned long long old_words[WORDS_PER_ROW];
+	for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+	{
+		old_words[word_num] = reached[word_num];
+		if(has_from_row) reached[word_num] |= in_out_reached.m_words[from_row * WORDS_PER_ROW + word_num] & open[word_num];
+	}
+
+	//east, toward higher bits, carrying into the next word's lowest bit
+	for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+	{
+		unsigned long long seed = reached[word_num];
+		if(word_num > 0) seed |= (reached[word_num - 1] >> (WORD_BITS - 1)) & open[word_num] & 1ull;
+		reached[word_num] = FillEast(seed, open[word_num]);
+	}
+
+	//west, toward lower bits, carrying into the previous word's highest bit
+	for(int word_num = WORDS_PER_ROW - 1; word_num >= 0; --word_num)
+	{
+		unsigned long long seed = reached[word_num];
+		if(word_num < WORDS_PER_ROW - 1) seed |= (reached[word_num + 1] << (WORD_BITS - 1)) & open[word_num];
+		reached[word_num] = FillWest(seed, open[word_num]);
+	}
+
+	bool has_changed = false;
+	for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+	{
+		has_changed |= reached[word_num] != old_words[word_num];
+	}
+
+	return has_changed;
+}
+
+
+//Kogge-Stone occluded fill, every seed runs toward higher bits while the open bits last
+unsigned long long BitBoard::FillEast(unsigned long long seed, unsigned long long open)
+{
+	seed |= open & (seed << 1);		open &= open << 1;
+	seed |= open & (seed << 2);		open &= open << 2;
+	seed |= open & (seed << 4);		open &= open << 4;
+	seed |= open & (seed << 8);		open &= open << 8;
+	seed |= open & (seed << 16);	open &= open << 16;
+	seed |= open & (seed << 32);
+	return seed;
+}
+
+
+unsigned long long BitBoard::FillWest(unsigned long long seed, unsigned long long open)
+{
+	seed |= open & (seed >> 1);		open &= open >> 1;
+	seed |= open & (seed >> 2);		open &= open >> 2;
+	seed |= open & (seed >> 4);		open &= open >> 4;
+	seed |= open & (seed >> 8);		open &= open >> 8;
+	seed |= open & (seed >> 16);	open &= open >> 16;
+	seed |= open & (seed >> 32);
+	return seed;
+}
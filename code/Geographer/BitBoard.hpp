@@ -0,0 +1,112 @@
+#pragma once
+#include "Arena/ArenaPlayerInterface.hpp"
+#include "Math/IntVec2.hpp"
+#include <utility>
+
+//one bit per tile, a row of the widest map is four 64 bit words. Rows never share a word,
+//so a step east or west is a shift with a carry between the row's own words and a step
+//north or south is the row above or below. Whole frontiers move a layer per pass
+class BitBoard
+{
+public:
+	static constexpr int WORD_BITS = 64;
+	static constexpr int WORDS_PER_ROW = (MAX_ARENA_WIDTH + WORD_BITS - 1) / WORD_BITS;
+	static constexpr int NUM_ROWS = MAX_ARENA_WIDTH;
+	static constexpr int NUM_WORDS = WORDS_PER_ROW * NUM_ROWS;
+
+public:
+	BitBoard() = default;
+	~BitBoard() = default;
+
+	//mutators
+	void	Clear();
+	void	Fill(int width);
+	void	Set(const IntVec2& coord);
+	void	Reset(const IntVec2& coord);
+	void	SetSpan(int row, int min_x, int max_x);
+	void	Or(const BitBoard& other);
+	void	OrRows(const BitBoard& other, int min_row, int max_row);
+	void	And(const BitBoard& other);
+	void	AndNot(const BitBoard& other);
+
+	//accessors
+	bool	Test(const IntVec2& coord) const;
+	bool	IsEmpty() const;
+	int		Count() const;
+
+	//kernels
+	static bool	Expand(const BitBoard& frontier, const BitBoard& passable, const BitBoard& reached,
+					BitBoard& out_next, int& in_out_min_row, int& in_out_max_row);
+	static void	FloodFill(BitBoard& in_out_reached, const BitBoard& passable);
+
+	template <typename Visitor>
+	static int	ForEachLayer(const IntVec2& start, const BitBoard& passable, int max_depth, BitBoard& scratch_reached,
+					BitBoard (&scratch_layers)[2], Visitor visit);
+
+	template <typename Visitor>
+	void	ForEachSet(int min_row, int max_row, Visitor visit) const;
+
+private:
+	static int	LowestBit(unsigned long long word);
+	bool		IsRowEmpty(int row) const;
+	static bool	FillRow(BitBoard& in_out_reached, const BitBoard& passable, int row, int from_row);
+	static unsigned long long	FillEast(unsigned long long seed, unsigned long long open);
+	static unsigned long long	FillWest(unsigned long long seed, unsigned long long open);
+
+private:
+	unsigned long long	m_words[NUM_WORDS] = { 0 };
+};
+
+
+//visit(x, y) for every set bit in the rows asked for, lowest x first
+template <typename Visitor>
+void BitBoard::ForEachSet(const int min_row, const int max_row, Visitor visit) const
+{
+	for(int row = min_row; row <= max_row; ++row)
+	{
+		for(int word_num = 0; word_num < WORDS_PER_ROW; ++word_num)
+		{
+			unsigned long long word = m_words[row * WORDS_PER_ROW + word_num];
+			while(word != 0)
+			{
+				visit(word_num * WORD_BITS + LowestBit(word), row);
+				word &= word - 1;
+			}
+		}
+	}
+}
+
+
+//breadth first out of start over passable, visit(x, y, depth) once per tile within max_depth
+//steps, start first at 0. Each pass settles a whole layer, returns how many tiles were visited
+template <typename Visitor>
+int BitBoard::ForEachLayer(const IntVec2& start, const BitBoard& passable, const int max_depth,
+	BitBoard& scratch_reached, BitBoard (&scratch_layers)[2], Visitor visit)
+{
+	BitBoard* frontier = &scratch_layers[0];
+	BitBoard* next = &scratch_layers[1];
+	scratch_reached.Clear();
+	scratch_reached.Set(start);
+	frontier->Clear();
+	frontier->Set(start);
+	visit(start.x, start.y, 0);
+
+	int num_visited = 1;
+	int min_row = start.y;
+	int max_row = start.y;
+	for(int depth = 1; depth <= max_depth; ++depth)
+	{
+		if(!Expand(*frontier, passable, scratch_reached, *next, min_row, max_row)) break;
+
+		next->ForEachSet(min_row, max_row, [&](const int x_idx, const int y_idx)
+		{
+			visit(x_idx, y_idx, depth);
+			++num_visited;
+		});
+
+		scratch_reached.OrRows(*next, min_row, max_row);
+		std::swap(frontier, next);
+	}
+
+	return num_visited;
+}
@@ -0,0 +1,337 @@
+#include "Geographer/DStarLite.hpp"
+#include "Geographer/Geographer.hpp"
+#include <algorithm>
+#include <functional>
+
+
+//--------------------------------------------------------------------------
+// planning
+
+
+//drops every tile the planner has touched, the next replan starts from nothing
+void DStarLite::Reset()
+{
+	m_nodes = std::unordered_map<int, PlannerNode>();
+	m_openList = std::vector<PlannerEntry>();
+	m_changedTiles.clear();
+	m_numOpen = 0;
+	m_startIdx = -1;
+	m_goalIdx = -1;
+	m_keyModifier = 0.0f;
+	m_changeCursor = -1;
+	m_numExpansions = 0;
+}
+
+
+//same goal and cost model as last time only repairs around the tiles that changed since,
+//anything else starts a new search. A search that runs out of expansions is left queued and
+//picks up where it stopped on the next replan
+std::vector<eOrderCode> DStarLite::Replan(const IntVec2& start, const IntVec2& goal, const bool for_worker,
+	const eCarryState carry_state)
+{
+	std::vector<eOrderCode> order_list;
+	if(start == goal || !Geographer::IsReachable(start, goal, for_worker))
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	const int start_idx = Geographer::GetTileIndex(start);
+	const int goal_idx = Geographer::GetTileIndex(goal);
+
+	m_changedTiles.clear();
+	const bool is_same_search = goal_idx == m_goalIdx && for_worker == m_forWorker && carry_state == m_carryState &&
+		static_cast<int>(m_nodes.size()) <= MAX_INCREMENTAL_NODES &&
+		Geographer::GetTilesChangedSince(m_changeCursor, m_changedTiles);
+
+	if(!is_same_search)
+	{
+		Restart(start_idx, goal_idx, for_worker, carry_state);
+	}
+	else
+	{
+		//queued keys were measured from the old start, the drift keeps new ones comparable
+		if(start_idx != m_startIdx)
+		{
+			m_keyModifier += Heuristic(m_startIdx, start_idx);
+			m_startIdx = start_idx;
+		}
+
+		for(const int tile_idx : m_changedTiles)
+		{
+			RepairAround(tile_idx);
+		}
+	}
+
+	m_numExpansions = 0;
+	ComputeShortestPath();
+
+	//walk down the cost field, always into a tile strictly closer to the goal so a search
+	//that is still settling can never send the ant around in a loop
+	int current_idx = m_startIdx;
+	float current_cost = FLT_MAX;
+	while(current_idx != m_goalIdx && order_list.size() < MAX_PATH)
+	{
+		int best_idx = -1;
+		eOrderCode best_order = ORDER_HOLD;
+		float best_cost = FLT_MAX;
+
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int neighbor_idx = neighbor.GetTileIndex();
+			const float step_cost = GetStepCost(neighbor_idx);
+			const float neighbor_cost = GetCostToGoal(neighbor_idx);
+			if(step_cost == FLT_MAX || neighbor_cost >= current_cost) continue;
+
+			if(step_cost + neighbor_cost < best_cost)
+			{
+				best_idx = neighbor_idx;
+				best_order = neighbor.GetMoveOrder();
+				best_cost = step_cost + neighbor_cost;
+			}
+		}
+
+		if(best_idx == -1) break;
+
+		order_list.push_back(best_order);
+		current_cost = GetCostToGoal(best_idx);
+		current_idx = best_idx;
+	}
+
+	if(order_list.empty())
+	{
+		order_list.push_back(ORDER_HOLD);
+	}
+
+	return order_list;
+}
+
+
+int DStarLite::GetNumExpansions() const
+{
+	return m_numExpansions;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+void DStarLite::Restart(const int start_index, const int goal_index, const bool for_worker, const eCarryState carry_state)
+{
+	m_nodes.clear();
+	m_openList.clear();
+	m_numOpen = 0;
+	m_startIdx = start_index;
+	m_goalIdx = goal_index;
+	m_forWorker = for_worker;
+	m_carryState = carry_state;
+	m_keyModifier = 0.0f;
+	m_changeCursor = Geographer::GetChangedTileCursor();
+
+	PlannerNode& goal_node = GetNode(goal_index);
+	goal_node.m_lookahead = 0.0f;
+	QueueNode(goal_index, goal_node);
+}
+
+
+//a changed tile only changes the cost of stepping into it, so its neighbors are the ones to
+//recheck. A neighbor the search never touched could not have been routing through it
+void DStarLite::RepairAround(const int tile_index)
+{
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int neighbor_idx = neighbor.GetTileIndex();
+		if(m_nodes.find(neighbor_idx) != m_nodes.end())
+		{
+			UpdateNode(neighbor_idx);
+		}
+	}
+}
+
+
+//settles queued tiles until the start is settled and nothing queued could still beat it
+void DStarLite::ComputeShortestPath()
+{
+	while(m_numExpansions < MAX_INCREMENTAL_EXPANSIONS)
+	{
+		PopStaleEntries();
+		if(m_openList.empty()) break;
+
+		const PlannerEntry top = m_openList.front();
+		const auto start_iter = m_nodes.find(m_startIdx);
+		const PlannerNode start_node = start_iter != m_nodes.end() ? start_iter->second : PlannerNode();
+		if(!(top.m_key < CalculateKey(m_startIdx, start_node)) &&
+			start_node.m_lookahead == start_node.m_costToGoal) break;
+
+		std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<PlannerEntry>());
+		m_openList.pop_back();
+		++m_numExpansions;
+
+		PlannerNode& node = GetNode(top.m_idx);
+		const PlannerKey new_key = CalculateKey(top.m_idx, node);
+		if(top.m_key < new_key)
+		{
+			//queued before the start moved, it goes back in at its real place
+			node.m_openKey = new_key;
+			m_openList.push_back({top.m_idx, new_key});
+			std::push_heap(m_openList.begin(), m_openList.end(), std::greater<PlannerEntry>());
+			continue;
+		}
+
+		node.m_isOpen = false;
+		--m_numOpen;
+
+		if(node.m_costToGoal > node.m_lookahead)
+		{
+			node.m_costToGoal = node.m_lookahead;
+		}
+		else
+		{
+			//got dearer, raise it and let it and everything that leaned on it find another way
+			node.m_costToGoal = FLT_MAX;
+			UpdateNode(top.m_idx);
+		}
+
+		for(NeighborIterator neighbor(top.m_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			UpdateNode(neighbor.GetTileIndex());
+		}
+	}
+
+	if(static_cast<int>(m_openList.size()) > 4 * m_numOpen + 64)
+	{
+		CompactOpenList();
+	}
+}
+
+
+void DStarLite::UpdateNode(const int tile_index)
+{
+	if(tile_index == m_goalIdx) return;
+
+	PlannerNode& node = GetNode(tile_index);
+	node.m_lookahead = GetBestLookahead(tile_index);
+	QueueNode(tile_index, node);
+}
+
+
+void DStarLite::QueueNode(const int tile_index, PlannerNode& node)
+{
+	if(node.m_costToGoal == node.m_lookahead)
+	{
+		if(node.m_isOpen)
+		{
+			node.m_isOpen = false;
+			--m_numOpen;
+		}
+		return;
+	}
+
+	const PlannerKey key = CalculateKey(tile_index, node);
+	if(node.m_isOpen && node.m_openKey == key) return;
+
+	if(!node.m_isOpen)
+	{
+		node.m_isOpen = true;
+		++m_numOpen;
+	}
+
+	node.m_openKey = key;
+	m_openList.push_back({tile_index, key});
+	std::push_heap(m_openList.begin(), m_openList.end(), std::greater<PlannerEntry>());
+}
+
+
+void DStarLite::PopStaleEntries()
+{
+	while(!m_openList.empty())
+	{
+		const PlannerEntry& top = m_openList.front();
+		const auto node_iter = m_nodes.find(top.m_idx);
+		if(node_iter->second.m_isOpen && node_iter->second.m_openKey == top.m_key) return;
+
+		std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<PlannerEntry>());
+		m_openList.pop_back();
+	}
+}
+
+
+//rebuilds the heap from the tiles that are really queued once left behind entries pile up
+void DStarLite::CompactOpenList()
+{
+	m_openList.clear();
+	for(const auto& node_pair : m_nodes)
+	{
+		if(node_pair.second.m_isOpen)
+		{
+			m_openList.push_back({node_pair.first, node_pair.second.m_openKey});
+		}
+	}
+
+	std::make_heap(m_openList.begin(), m_openList.end(), std::greater<PlannerEntry>());
+}
+
+
+//same costs as the HPA* and colony fields, one per step plus the tile's exhaust,
+//FLT_MAX when the ant can not stand there
+float DStarLite::GetStepCost(const int to_index) const
+{
+	const eAgentType agent_type = m_forWorker ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	if(!Geographer::IsWalkableTile(to_index, agent_type, m_carryState)) return FLT_MAX;
+	return 1.0f + Geographer::GetExhaustPenalty(Geographer::s_perceivedTypes[to_index], agent_type, m_carryState);
+}
+
+
+float DStarLite::GetBestLookahead(const int tile_index) const
+{
+	float best_cost = FLT_MAX;
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int neighbor_idx = neighbor.GetTileIndex();
+		const float step_cost = GetStepCost(neighbor_idx);
+		const float neighbor_cost = GetCostToGoal(neighbor_idx);
+		if(step_cost == FLT_MAX || neighbor_cost == FLT_MAX) continue;
+
+		best_cost = std::min(best_cost, step_cost + neighbor_cost);
+	}
+
+	return best_cost;
+}
+
+
+float DStarLite::GetCostToGoal(const int tile_index) const
+{
+	const auto node_iter = m_nodes.find(tile_index);
+	if(node_iter == m_nodes.end()) return FLT_MAX;
+	return node_iter->second.m_costToGoal;
+}
+
+
+//every step costs at least one, so manhattan never overestimates
+float DStarLite::Heuristic(const int from_index, const int to_index) const
+{
+	const int width = Geographer::s_mapDimensions;
+	const int x_dist = abs(from_index % width - to_index % width);
+	const int y_dist = abs(from_index / width - to_index / width);
+	return static_cast<float>(x_dist + y_dist);
+}
+
+
+DStarLite::PlannerKey DStarLite::CalculateKey(const int tile_index, const PlannerNode& node) const
+{
+	PlannerKey key;
+	key.m_secondary = std::min(node.m_costToGoal, node.m_lookahead);
+	if(key.m_secondary != FLT_MAX)
+	{
+		key.m_primary = key.m_secondary + Heuristic(m_startIdx, tile_index) + m_keyModifier;
+	}
+
+	return key;
+}
+
+
+DStarLite::PlannerNode& DStarLite::GetNode(const int tile_index)
+{
+	return m_nodes[tile_index];
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "Blackboard.hpp"
+#include "Math/IntVec2.hpp"
+#include <unordered_map>
+#include <vector>
+
+//D* Lite for one ant. The search grows backward from the goal, so the tree it leaves behind
+//is still good after the ant walks along it, and a tile that changes only repairs the part of
+//the tree that routed through it. Tiles are only stored once the search touches them, an
+//idle planner holds nothing
+class DStarLite
+{
+	struct PlannerKey
+	{
+		float m_primary = FLT_MAX;
+		float m_secondary = FLT_MAX;
+
+		friend bool operator<(const PlannerKey& lhs, const PlannerKey& rhs)
+		{
+			if(lhs.m_primary != rhs.m_primary) return lhs.m_primary < rhs.m_primary;
+			return lhs.m_secondary < rhs.m_secondary;
+		}
+
+		friend bool operator==(const PlannerKey& lhs, const PlannerKey& rhs)
+		{
+			return lhs.m_primary == rhs.m_primary && lhs.m_secondary == rhs.m_secondary;
+		}
+	};
+
+	//m_lookahead is the best neighbor's cost plus the step into it, the tile is settled
+	//when it matches m_costToGoal and is queued while they differ
+	struct PlannerNode
+	{
+		float		m_costToGoal = FLT_MAX;
+		float		m_lookahead = FLT_MAX;
+		PlannerKey	m_openKey;
+		bool		m_isOpen = false;
+	};
+
+	//the open list is never searched, a re-keyed or settled tile leaves its old entry behind
+	//and entries that no longer match their node are dropped when they reach the top
+	struct PlannerEntry
+	{
+		int			m_idx = -1;
+		PlannerKey	m_key;
+
+		friend bool operator>(const PlannerEntry& lhs, const PlannerEntry& rhs)
+		{
+			return rhs.m_key < lhs.m_key;
+		}
+	};
+
+public:
+	DStarLite() = default;
+	~DStarLite() = default;
+
+	void					Reset();
+	std::vector<eOrderCode>	Replan( const IntVec2& start, const IntVec2& goal, bool for_worker,
+								eCarryState carry_state = CARRY_NOTHING );
+	int						GetNumExpansions() const;
+
+private:
+	void				Restart( int start_index, int goal_index, bool for_worker, eCarryState carry_state );
+	void				RepairAround( int tile_index );
+	void				ComputeShortestPath();
+	void				UpdateNode( int tile_index );
+	void				QueueNode( int tile_index, PlannerNode& node );
+	void				PopStaleEntries();
+	void				CompactOpenList();
+	float				GetStepCost( int to_index ) const;
+	float				GetBestLookahead( int tile_index ) const;
+	float				GetCostToGoal( int tile_index ) const;
+	float				Heuristic( int from_index, int to_index ) const;
+	PlannerKey			CalculateKey( int tile_index, const PlannerNode& node ) const;
+	PlannerNode&		GetNode( int tile_index );
+
+private:
+	std::unordered_map<int, PlannerNode>	m_nodes;
+	std::vector<PlannerEntry>				m_openList;
+	std::vector<int>						m_changedTiles;
+	int		m_numOpen = 0;
+	int		m_startIdx = -1;
+	int		m_goalIdx = -1;
+	bool	m_forWorker = true;
+	eCarryState	m_carryState = CARRY_NOTHING;	//a carrier can not dig, so it walks its own cost table
+	float	m_keyModifier = 0.0f;	//heuristic drift from every step the start has taken
+	int		m_changeCursor = -1;
+	int		m_numExpansions = 0;
+};
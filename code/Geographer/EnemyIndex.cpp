@@ -0,0 +1,205 @@
+#include "Geographer/EnemyIndex.hpp"
+#include "Math/MathUtils.hpp"
+#include <cstring>
+
+
+bool AgentFilter::IsMatch(const eAgentType agent_type, const TeamID team_id) const
+{
+	if(agent_type >= NUM_AGENT_TYPES || team_id == m_ignoredTeam) return false;
+	return ((m_typeMask >> agent_type) & 1) != 0;
+}
+
+
+//--------------------------------------------------------------------------
+// mutators
+
+
+//a counting sort by cell. Each cell's count lands one slot ahead so the running sum turns it
+//into the cell's start, placing the agents then walks every start up to the next cell's
+void EnemyIndex::Rebuild(const ObservedAgent* observed_agents, const int num_observed, const int map_width)
+{
+	m_cellsPerRow = (map_width + ENEMY_CELL_WIDTH - 1) / ENEMY_CELL_WIDTH;
+	const int num_cells = m_cellsPerRow * m_cellsPerRow;
+	memset(m_cellStart, 0, (num_cells + 1) * sizeof(int));
+
+	const auto is_on_map = [map_width](const ObservedAgent& agent)
+	{
+		return agent.tileX >= 0 && agent.tileX < map_width && agent.tileY >= 0 && agent.tileY < map_width;
+	};
+
+	for(int observed_idx = 0; observed_idx < num_observed; ++observed_idx)
+	{
+		const ObservedAgent& agent = observed_agents[observed_idx];
+		if(!is_on_map(agent)) continue;
+
+		++m_cellStart[GetCellIndex(agent.tileX, agent.tileY) + 1];
+	}
+
+	for(int cell_idx = 0; cell_idx < num_cells; ++cell_idx)
+	{
+		m_cellStart[cell_idx + 1] += m_cellStart[cell_idx];
+	}
+
+	m_numAgents = m_cellStart[num_cells];
+	for(int observed_idx = 0; observed_idx < num_observed; ++observed_idx)
+	{
+		const ObservedAgent& agent = observed_agents[observed_idx];
+		if(!is_on_map(agent)) continue;
+
+		IndexedAgent& indexed_agent = m_agents[m_cellStart[GetCellIndex(agent.tileX, agent.tileY)]++];
+		indexed_agent.m_agentID = agent.agentID;
+		indexed_agent.m_tileX = agent.tileX;
+		indexed_agent.m_tileY = agent.tileY;
+		indexed_agent.m_observedIdx = static_cast<short>(observed_idx);
+		indexed_agent.m_type = agent.type;
+		indexed_agent.m_teamID = agent.teamID;
+	}
+
+	//every start has walked up to the next cell's, shift them back down
+	for(int cell_idx = num_cells; cell_idx > 0; --cell_idx)
+	{
+		m_cellStart[cell_idx] = m_cellStart[cell_idx - 1];
+	}
+
+	m_cellStart[0] = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// queries
+
+
+int EnemyIndex::GetNumAgents() const
+{
+	return m_numAgents;
+}
+
+
+int EnemyIndex::CountAgents(const AgentFilter& filter) const
+{
+	int num_matches = 0;
+	for(int agent_idx = 0; agent_idx < m_numAgents; ++agent_idx)
+	{
+		if(filter.IsMatch(m_agents[agent_idx].m_type, m_agents[agent_idx].m_teamID)) ++num_matches;
+	}
+
+	return num_matches;
+}
+
+
+//the closest max_hits matches, nearest first. Cells are read a ring at a time outward from the
+//coord's cell, and the search stops once no tile in the next ring could beat the worst hit
+int EnemyIndex::FindNearest(const IntVec2& coord, const AgentFilter& filter, const int max_hits,
+	AgentHit* out_hits) const
+{
+	int num_hits = 0;
+	if(max_hits <= 0 || m_numAgents == 0) return 0;
+
+	const int cell_x = coord.x / ENEMY_CELL_WIDTH;
+	const int cell_y = coord.y / ENEMY_CELL_WIDTH;
+	for(int ring = 0; ring < m_cellsPerRow; ++ring)
+	{
+		//a tile in ring r is at least r - 1 whole cells and one more step away
+		if(num_hits == max_hits && out_hits[num_hits - 1].m_distance <= (ring - 1) * ENEMY_CELL_WIDTH) break;
+
+		GatherRing(coord, cell_x, cell_y, ring, filter, max_hits, out_hits, num_hits);
+	}
+
+	return num_hits;
+}
+
+
+//up to max_hits matches within radius taxicab steps, in cell order rather than by distance
+int EnemyIndex::FindWithinRadius(const IntVec2& coord, const int radius, const AgentFilter& filter,
+	const int max_hits, AgentHit* out_hits) const
+{
+	int num_hits = 0;
+	if(max_hits <= 0 || m_numAgents == 0 || radius < 0) return 0;
+
+	const int max_cell = m_cellsPerRow - 1;
+	const int min_cell_x = ClampInt((coord.x - radius) / ENEMY_CELL_WIDTH, 0, max_cell);
+	const int max_cell_x = ClampInt((coord.x + radius) / ENEMY_CELL_WIDTH, 0, max_cell);
+	const int min_cell_y = ClampInt((coord.y - radius) / ENEMY_CELL_WIDTH, 0, max_cell);
+	const int max_cell_y = ClampInt((coord.y + radius) / ENEMY_CELL_WIDTH, 0, max_cell);
+
+	for(int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y)
+	{
+		for(int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x)
+		{
+			const int cell_idx = cell_y * m_cellsPerRow + cell_x;
+			for(int agent_idx = m_cellStart[cell_idx]; agent_idx < m_cellStart[cell_idx + 1]; ++agent_idx)
+			{
+				const IndexedAgent& agent = m_agents[agent_idx];
+				if(!filter.IsMatch(agent.m_type, agent.m_teamID)) continue;
+
+				const int distance = Abs(agent.m_tileX - coord.x) + Abs(agent.m_tileY - coord.y);
+				if(distance > radius) continue;
+
+				out_hits[num_hits].m_agent = agent;
+				out_hits[num_hits].m_distance = distance;
+				if(++num_hits == max_hits) return num_hits;
+			}
+		}
+	}
+
+	return num_hits;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+int EnemyIndex::GetCellIndex(const int x_idx, const int y_idx) const
+{
+	return (y_idx / ENEMY_CELL_WIDTH) * m_cellsPerRow + x_idx / ENEMY_CELL_WIDTH;
+}
+
+
+//the cells exactly ring cells from the center one, whole rows at the top and bottom and just
+//the two ends of every row between
+void EnemyIndex::GatherRing(const IntVec2& coord, const int cell_x, const int cell_y, const int ring,
+	const AgentFilter& filter, const int max_hits, AgentHit* out_hits, int& in_out_num_hits) const
+{
+	for(int offset_y = -ring; offset_y <= ring; ++offset_y)
+	{
+		const int ring_y = cell_y + offset_y;
+		if(ring_y < 0 || ring_y >= m_cellsPerRow) continue;
+
+		const bool is_edge_row = offset_y == -ring || offset_y == ring;
+		const int step_x = is_edge_row ? 1 : 2 * ring;
+		for(int offset_x = -ring; offset_x <= ring; offset_x += step_x)
+		{
+			const int ring_x = cell_x + offset_x;
+			if(ring_x < 0 || ring_x >= m_cellsPerRow) continue;
+
+			const int cell_idx = ring_y * m_cellsPerRow + ring_x;
+			for(int agent_idx = m_cellStart[cell_idx]; agent_idx < m_cellStart[cell_idx + 1]; ++agent_idx)
+			{
+				const IndexedAgent& agent = m_agents[agent_idx];
+				if(!filter.IsMatch(agent.m_type, agent.m_teamID)) continue;
+
+				const int distance = Abs(agent.m_tileX - coord.x) + Abs(agent.m_tileY - coord.y);
+				InsertNearest(agent, distance, max_hits, out_hits, in_out_num_hits);
+			}
+		}
+	}
+}
+
+
+//keeps out_hits sorted nearest first, a full list drops its farthest to make room
+void EnemyIndex::InsertNearest(const IndexedAgent& agent, const int distance, const int max_hits,
+	AgentHit* out_hits, int& in_out_num_hits)
+{
+	if(in_out_num_hits == max_hits && distance >= out_hits[max_hits - 1].m_distance) return;
+
+	int slot_idx = in_out_num_hits < max_hits ? in_out_num_hits++ : max_hits - 1;
+	while(slot_idx > 0 && out_hits[slot_idx - 1].m_distance > distance)
+	{
+		out_hits[slot_idx] = out_hits[slot_idx - 1];
+		--slot_idx;
+	}
+
+	out_hits[slot_idx].m_agent = agent;
+	out_hits[slot_idx].m_distance = distance;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Arena/ArenaPlayerInterface.hpp"
+#include "Math/IntVec2.hpp"
+
+//the map is cut into square cells, each cell's agents sit next to each other in one array.
+//Rebuilt whole every turn with a counting sort, so nothing is allocated and nothing is kept
+constexpr int ENEMY_CELL_WIDTH = 8;
+constexpr int MAX_ENEMY_CELLS_PER_ROW = (MAX_ARENA_WIDTH + ENEMY_CELL_WIDTH - 1) / ENEMY_CELL_WIDTH;
+constexpr int MAX_ENEMY_CELLS = MAX_ENEMY_CELLS_PER_ROW * MAX_ENEMY_CELLS_PER_ROW;
+constexpr unsigned int ALL_AGENT_TYPES_MASK = (1u << NUM_AGENT_TYPES) - 1;
+
+//what a query counts, bit (1 << type) of m_typeMask per agent type. Agents on m_ignoredTeam
+//are skipped, the server's team ids start at 200 so the default skips nobody
+struct AgentFilter
+{
+	unsigned int	m_typeMask = ALL_AGENT_TYPES_MASK;
+	TeamID			m_ignoredTeam = 0;
+
+	bool IsMatch(eAgentType agent_type, TeamID team_id) const;
+};
+
+//one observed agent as the index keeps it, m_observedIdx is its slot in observedAgents
+struct IndexedAgent
+{
+	AgentID		m_agentID = 0;
+	short		m_tileX = -1;
+	short		m_tileY = -1;
+	short		m_observedIdx = -1;
+	eAgentType	m_type = INVALID_AGENT_TYPE;
+	TeamID		m_teamID = 0;
+};
+
+//a query result, m_distance is in taxicab steps
+struct AgentHit
+{
+	IndexedAgent	m_agent;
+	int				m_distance = 0;
+};
+
+class EnemyIndex
+{
+public:
+	EnemyIndex() = default;
+	~EnemyIndex() = default;
+
+	//mutators
+	void	Rebuild(const ObservedAgent* observed_agents, int num_observed, int map_width);
+
+	//queries, the caller's array holds the results so none of them allocate
+	int		GetNumAgents() const;
+	int		CountAgents(const AgentFilter& filter) const;
+	int		FindNearest(const IntVec2& coord, const AgentFilter& filter, int max_hits, AgentHit* out_hits) const;
+	int		FindWithinRadius(const IntVec2& coord, int radius, const AgentFilter& filter, int max_hits,
+				AgentHit* out_hits) const;
+
+private:
+	int		GetCellIndex(int x_idx, int y_idx) const;
+	void	GatherRing(const IntVec2& coord, int cell_x, int cell_y, int ring, const AgentFilter& filter,
+				int max_hits, AgentHit* out_hits, int& in_out_num_hits) const;
+	static void	InsertNearest(const IndexedAgent& agent, int distance, int max_hits, AgentHit* out_hits,
+					int& in_out_num_hits);
+
+private:
+	int				m_cellsPerRow = 0;
+	int				m_numAgents = 0;
+	int				m_cellStart[MAX_ENEMY_CELLS + 1] = {};	//a cell's agents are [start, next cell's start)
+	IndexedAgent	m_agents[MAX_AGENTS_TOTAL];
+};
@@ -3,6 +3,7 @@
 #include <string>
 #include <algorithm>
 #include <random>
+#include <cstring>
 #include "Geographer/SearchGraph.hpp"
 #include "Math/MathUtils.hpp"
 #include "Architecture/ErrorWarningAssert.hpp"
@@ -15,12 +16,19 @@
 STATIC Geographer*			Geographer::s_instance = nullptr;
 STATIC int					Geographer::s_mapDimensions = 0;
 STATIC int					Geographer::s_mapTotalSize = 0;
-STATIC TileRecord			Geographer::s_perceivedMap[MAX_ARENA_TILES];
-STATIC NodeRecord			Geographer::s_pathingMap[MAX_ARENA_TILES];
-STATIC std::vector<short>	Geographer::s_foodLoc = std::vector<short>();
-STATIC std::vector<short>	Geographer::s_enemyLoc = std::vector<short>();
-
-STATIC const NodeRecord		Geographer::DEFAULT_PATHING_MAP[MAX_ARENA_TILES];
+STATIC eTileType			Geographer::s_perceivedTypes[MAX_ARENA_TILES];
+STATIC unsigned long long	Geographer::s_perceivedFood[TILE_MASK_WORDS];
+STATIC int					Geographer::s_lastSeenTurn[MAX_ARENA_TILES];
+STATIC std::unordered_map<int, AgentID>	Geographer::s_foodClaims;
+STATIC thread_local PathingScratch*	Geographer::s_scratch = nullptr;
+STATIC int					Geographer::s_neighborOffsets[NUM_NEIGHBOR_DIRS];
+STATIC unsigned char		Geographer::s_neighborMask[MAX_ARENA_TILES];
+STATIC float				Geographer::s_exhaustPenalty[NUM_AGENT_TYPES][NUM_CARRY_STATES][NUM_TILE_TYPE_VALUES];
+STATIC bool					Geographer::s_mustDigToEnter[NUM_AGENT_TYPES][NUM_TILE_TYPE_VALUES];
+STATIC short				Geographer::s_jumpDistance[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES][NUM_CARDINAL_DIRS];
+STATIC bool					Geographer::s_jumpTableDirty = true;
+STATIC BitBoard				Geographer::s_tilePlanes[NUM_TILE_PLANES];
+STATIC EnemyIndex			Geographer::s_enemyIndex;
 
 
 //--------------------------------------------------------------------------
@@ -40,6 +48,13 @@ Geographer::~Geographer()
 STATIC void Geographer::Startup()
 {
 	Geographer startup = GetInstance();
+	BuildCostTables();
+
+	memset(s_perceivedTypes, TILE_TYPE_UNSEEN, sizeof(s_perceivedTypes));
+	memset(s_perceivedFood, 0, sizeof(s_perceivedFood));
+	memset(s_lastSeenTurn, 0, sizeof(s_lastSeenTurn));
+	s_foodClaims.clear();
+
 	SetMapDimensions(g_matchInfo.mapWidth);
 }
 
@@ -54,7 +69,6 @@ STATIC void Geographer::Shutdown()
 STATIC void Geographer::Update()
 {
 	UpdatePerception();
-	//UpdateListOfFood();
 }
 
 
@@ -75,34 +89,26 @@ STATIC Geographer Geographer::GetInstance()
 
 STATIC bool Geographer::DoesCoordHaveFood(const IntVec2& coord)
 {
-	const short tile_idx = GetTileIndex(coord); 
-	return s_perceivedMap[tile_idx].m_hasFood;
+	const int tile_idx = GetTileIndex(coord); 
+	return DoesTileHaveFood(tile_idx);
 }
 
 
 TODO("Ask for Unit type")
 STATIC bool Geographer::IsSafeTile( const IntVec2& coord )
 {
-	short tile_index = GetTileIndex(coord);
-	const eTileType tile_type = s_perceivedMap[tile_index].m_tileType;
+	int tile_index = GetTileIndex(coord);
+	const eTileType tile_type = s_perceivedTypes[tile_index];
 	return !(tile_type == TILE_TYPE_STONE);
 }
 
 bool Geographer::IsTileSurrounded(const IntVec2& coord)
 {
-	std::vector<IntVec2> neighboring_tiles = FourNeighbors(coord);
 	int num_stone_walls = 0;
 	
-	for(int tile_idx = 0; tile_idx < 4; ++tile_idx)
+	for(NeighborIterator neighbor(GetTileIndex(coord)); neighbor.IsValid(); neighbor.Next())
 	{
-		if(neighboring_tiles[tile_idx] == IntVec2::NEG_ONE)
-		{
-			continue;
-		}
-
-		short tile_serial = GetTileIndex(neighboring_tiles[tile_idx]);
-		
-		if (s_perceivedMap[tile_serial].m_tileType == TILE_TYPE_STONE)
+		if (s_perceivedTypes[neighbor.GetTileIndex()] == TILE_TYPE_STONE)
 		{
 			++num_stone_walls;
 		}
@@ -112,182 +118,150 @@ bool Geographer::IsTileSurrounded(const IntVec2& coord)
 }
 
 
-STATIC std::vector<IntVec2> Geographer::FourNeighbors(const IntVec2& coord)
+//every carrier reads the same field, so getting home is one lookup instead of one A* each.
+//ORDER_HOLD when the queen is unknown, already here, or cut off by stone
+STATIC eOrderCode Geographer::GetOrderTowardQueen(const IntVec2& coord)
 {
-	IntVec2 dir[] = {
-		IntVec2(1, 0),
-		IntVec2(0, 1),
-		IntVec2(-1, 0),
-		IntVec2(0, -1)};
-
-	std::vector<IntVec2> result;
-
-	for (auto& idx : dir)
-	{
-		IntVec2 test_coord(coord.x + idx.x, coord.y + idx.y);
-		if(!IsValidCoord(test_coord)) 
-		{
-			result.emplace_back(IntVec2::NEG_ONE);
-		}
-		else
-		{
-			result.emplace_back(test_coord);
-		}
-	}
+	if(g_queenPos == IntVec2::NEG_ONE || coord == g_queenPos) return ORDER_HOLD;
 
-	return result;
+	UpdateQueenField();
+	return s_queenFlow[GetTileIndex(coord)];
 }
 
-std::vector<IntVec2> Geographer::EightNeighbors(const IntVec2& coord)
+
+//paths are stored as moves, a move into a tile this agent can only dig through goes out as the
+//dig in that direction. The ant stays put that turn and the same move walks in once it is air.
+//Nothing can be dug while carrying, a carrier walks in when its own table lets it and holds
+//otherwise, which the ant takes as its cue to repath
+STATIC eOrderCode Geographer::GetStepOrder(const IntVec2& coord, const eOrderCode move_order, const eAgentType agent_type,
+	const eCarryState carry_state)
 {
-	IntVec2 dir[] = {
-		IntVec2(1, 0),
-		IntVec2(1, 1),
-		IntVec2(0, 1),
-		IntVec2(-1, 1),
-		IntVec2(-1, 0),
-		IntVec2(-1, -1),
-		IntVec2(0, -1),
-		IntVec2(1, -1)};
+	if(move_order < ORDER_MOVE_EAST || move_order > ORDER_MOVE_SOUTH) return move_order;
 
-	std::vector<IntVec2> result;
+	const IntVec2 next_coord = GetCoordFromCardDir(move_order, coord);
+	if(!IsValidCoord(next_coord)) return move_order;
 
-	for (auto& idx : dir)
-	{
-		IntVec2 test_coord(coord.x + idx.x, coord.y + idx.y);
-		if(!IsValidCoord(test_coord) || !IsSafeTile(test_coord)) 
-		{
-			result.emplace_back(IntVec2(-1, -1));
-		}
-		else
-		{
-			result.emplace_back(test_coord);
-		}
-	}
+	const int next_idx = GetTileIndex(next_coord);
+	if(!s_mustDigToEnter[agent_type][s_perceivedTypes[next_idx]]) return move_order;
+	if(carry_state != CARRY_NOTHING) return IsWalkableTile(next_idx, agent_type, carry_state) ? move_order : ORDER_HOLD;
 
-	return result;
+	return static_cast<eOrderCode>(ORDER_DIG_EAST + (move_order - ORDER_MOVE_EAST));
 }
 
 
-STATIC void Geographer::UpdateListOfFood(const IntVec2& coord)
+//every unclaimed food tile is a source of the food field, so the count is kept as they come and go
+int Geographer::HowMuchFoodCanISee()
 {
-	s_foodLoc.clear();
-	const short start_idx = GetTileIndex(coord);
-	const int total_nodes_to_search = s_mapTotalSize;
-	int nodes_searched = 1;
-	
-	//Setup root node
-	s_pathingMap[start_idx].m_coord = coord;
-	s_pathingMap[start_idx].m_pathCost = 0;
-	s_pathingMap[start_idx].m_nodeState = NodeRecord::OPEN;
-	
-	MinHeap<NodePriority> frontier(s_mapTotalSize);
-	frontier.Push(NodePriority(start_idx, s_pathingMap[start_idx].m_pathCost));
-
-	NodeRecord current_node;
-	while(frontier.GetSize() > 0)
-	{
-		const NodePriority priority_node = frontier.Pop();
-		const short current_idx = priority_node.m_idx;
-		current_node = s_pathingMap[current_idx];
+	return s_numFoodSources;
+}
 
-		std::vector<IntVec2> connections = EightNeighbors(current_node.m_coord);
-		for(int con_idx = 0; con_idx < static_cast<int>(connections.size()); ++con_idx)
-		{
-			++nodes_searched;
-			//GetNeighbors will always return 4 elements, if invalid it returns (-1,-1)
-			if(connections[con_idx] == IntVec2(-1, -1)) continue;
+int Geographer::HowManyEnemiesCanISee()
+{
+	return s_enemyIndex.CountAgents(GetThreatFilter());
+}
 
-			NodeRecord new_node;
-			new_node.m_coord = connections[con_idx];
-			new_node.m_pathCost = nodes_searched;
-			
-			const short new_node_idx = GetTileIndex(new_node.m_coord);
+//the closest threat by taxicab steps, the index is only read so every soldier can ask
+IntVec2 Geographer::GetNearestEnemyCoord(const IntVec2& coord)
+{
+	if(!IsValidCoord(coord)) return IntVec2::NEG_ONE;
 
-			//if the node is in the closed list, then we may skip or remove it from the closed list
-			switch(s_pathingMap[new_node_idx].m_nodeState)
-			{
-			case NodeRecord::CLOSED:
-			case NodeRecord::OPEN:
-				{
-					break;
-				}
-			case NodeRecord::UNVISITED:
-				{
-					s_pathingMap[new_node_idx].m_coord = new_node.m_coord;
-					s_pathingMap[new_node_idx].m_pathCost = nodes_searched;
-					s_pathingMap[new_node_idx].m_nodeState = NodeRecord::OPEN;
-					frontier.Push(NodePriority(new_node_idx, new_node.m_pathCost));
-					break;
-				}
-			}
-		}
+	AgentHit nearest_hit;
+	if(s_enemyIndex.FindNearest(coord, GetThreatFilter(), 1, &nearest_hit) == 0) return IntVec2::NEG_ONE;
 
-		//Finished looking at all connections,
-		s_pathingMap[current_idx].m_nodeState = NodeRecord::CLOSED;
+	return IntVec2(nearest_hit.m_agent.m_tileX, nearest_hit.m_agent.m_tileY);
+}
 
-		if(s_perceivedMap[current_idx].m_goingToThisTile != UINT_MAX) continue;
-		if(s_perceivedMap[current_idx].m_hasFood)
-		{
-			s_foodLoc.push_back(current_idx);
-		}
-		
-		if(nodes_searched == total_nodes_to_search)	break;
-	}
+STATIC const EnemyIndex& Geographer::GetEnemyIndex()
+{
+	return s_enemyIndex;
+}
 
-		
-	std::reverse(s_foodLoc.begin(),s_foodLoc.end());
-		
-	ResetPathingMap();
+//scouts are not worth chasing and teammates are not threats
+STATIC AgentFilter Geographer::GetThreatFilter()
+{
+	AgentFilter threat_filter;
+	threat_filter.m_typeMask = ALL_AGENT_TYPES_MASK & ~(1u << AGENT_TYPE_SCOUT);
+	threat_filter.m_ignoredTeam = g_playerInfo.teamID;
+	return threat_filter;
 }
 
-int Geographer::HowMuchFoodCanISee()
+//every tile the agent can stand on, built from the tile type planes and the same exhaust
+//table the searches read, so it agrees with IsWalkableTile
+STATIC void Geographer::GetPassablePlane(const bool for_worker, BitBoard& out_passable)
 {
-	return s_foodLoc.size();
+	out_passable.Clear();
+	for(int type_idx = 0; type_idx < NUM_TILE_TYPES; ++type_idx)
+	{
+		if(GetExhaustPenalty(static_cast<eTileType>(type_idx), for_worker) < IMPASSABLE_PENALTY)
+			out_passable.Or(s_tilePlanes[type_idx]);
+	}
+
+	if(GetExhaustPenalty(TILE_TYPE_UNSEEN, for_worker) < IMPASSABLE_PENALTY)
+		out_passable.Or(s_tilePlanes[UNSEEN_TILE_PLANE]);
 }
 
-int Geographer::HowManyEnemiesCanISee()
+
+//whole map flood over the passable plane, a frontier ring per pass instead of a tile per pop
+STATIC void Geographer::GetReachableTiles(const IntVec2& start, const bool for_worker, BitBoard& out_reached)
 {
-	return s_enemyLoc.size();
+	BitBoard& passable = s_scratch->m_passable;
+
+	out_reached.Clear();
+	if(!IsValidCoord(start)) return;
+
+	GetPassablePlane(for_worker, passable);
+	out_reached.Set(start);
+	BitBoard::FloodFill(out_reached, passable);
 }
 
-IntVec2 Geographer::GetNextEnemyCoord()
+
+//unit cost breadth first distances out to max_depth steps, -1 for tiles not reached.
+//Each pass settles a whole layer, the layer's tiles are only visited to write their step
+STATIC int Geographer::GetStepDistances(const IntVec2& start, const bool for_worker, const int max_depth, short* out_steps)
 {
-	if(!s_enemyLoc.empty())
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
 	{
-		IntVec2 enemy_coord(GetTileCoord(s_enemyLoc.back()));
-		s_enemyLoc.pop_back();
-		return enemy_coord;
+		out_steps[tile_idx] = -1;
 	}
 
-	return IntVec2::NEG_ONE;
+	if(!IsValidCoord(start)) return 0;
+
+	GetPassablePlane(for_worker, s_scratch->m_passable);
+	return BitBoard::ForEachLayer(start, s_scratch->m_passable, max_depth, s_scratch->m_reached, s_scratch->m_layers,
+		[out_steps](const int x_idx, const int y_idx, const int depth)
+	{
+		out_steps[y_idx * s_mapDimensions + x_idx] = static_cast<short>(depth);
+	});
 }
 
+
 float Geographer::GetHeatMapValueAt(const IntVec2& coord, eMapData map_data)
 {
-	short coord_idx = GetTileIndex(coord);
+	int coord_idx = GetTileIndex(coord);
 
 	//kinda bad, assuming all map data is floats
 	switch(map_data)
 	{
 		case MAP_TILE_TYPE:
 		{
-			return static_cast<float>(s_perceivedMap[coord_idx].m_tileType);
+			return static_cast<float>(s_perceivedTypes[coord_idx]);
 			break;
 		}
 		case MAP_FOOD:
 		{
-			return static_cast<float>(s_perceivedMap[coord_idx].m_hasFood);
+			return static_cast<float>(DoesTileHaveFood(coord_idx));
 			break;
 		}
 		case MAP_LAST_UPDATED:
 		{
-			return static_cast<float>(s_perceivedMap[coord_idx].m_lastUpdated);
+			const bool is_in_seen_mask = (s_seenMask[coord_idx / 64] >> (coord_idx % 64)) & 1;
+			if(s_seenMaskTurn >= 0 && is_in_seen_mask) return static_cast<float>(s_seenMaskTurn);
+			return static_cast<float>(s_lastSeenTurn[coord_idx]);
 			break;
 		}
 		case MAP_ANT_RESERVE:
 		{
-			return static_cast<float>(s_perceivedMap[coord_idx].m_goingToThisTile);
+			return static_cast<float>(GetFoodClaim(coord_idx));
 			break;
 		}
 		default:
@@ -387,56 +361,120 @@ STATIC void Geographer::SetMapDimensions(const int width)
 {
 	s_mapDimensions = width;
 	s_mapTotalSize = width * width;
-}
 
+	s_neighborOffsets[NEIGHBOR_EAST] = 1;
+	s_neighborOffsets[NEIGHBOR_NORTH] = width;
+	s_neighborOffsets[NEIGHBOR_WEST] = -1;
+	s_neighborOffsets[NEIGHBOR_SOUTH] = -width;
+	s_neighborOffsets[NEIGHBOR_NORTH_EAST] = width + 1;
+	s_neighborOffsets[NEIGHBOR_NORTH_WEST] = width - 1;
+	s_neighborOffsets[NEIGHBOR_SOUTH_WEST] = -width - 1;
+	s_neighborOffsets[NEIGHBOR_SOUTH_EAST] = -width + 1;
+	s_jumpTableDirty = true;
+
+	//the abstract graph starts empty, every cluster is built on the first hierarchical search
+	s_clustersPerRow = (width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
+	{
+		for(int cluster_idx = 0; cluster_idx < MAX_CLUSTERS; ++cluster_idx)
+		{
+			s_clusters[model_idx][cluster_idx] = HierarchyCluster();
+		}
 
-STATIC void Geographer::UpdatePerception()
-{
-	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+		for(int tile_idx = 0; tile_idx < MAX_ARENA_TILES; ++tile_idx)
+		{
+			s_entranceSlot[model_idx][tile_idx] = -1;
+		}
+	}
+
+	s_queenFieldDirty = true;
+	s_foodFieldDirty = true;
+	s_pathCache.clear();
+
+	//nothing from the old map carries over, push every reader's cursor out of range
+	s_changedTilesBase += static_cast<int>(s_changedTiles.size()) + 1;
+	s_changedTiles.clear();
+	RebuildTilePlanes();
+
+	for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
 	{
-		if(g_turnState.observedTiles[tile_idx] == TILE_TYPE_UNSEEN) continue;
+		s_componentsDirty[model_idx] = true;
+	}
 
-		s_perceivedMap[tile_idx].m_tileType = g_turnState.observedTiles[tile_idx];
-		s_perceivedMap[tile_idx].m_hasFood = g_turnState.tilesThatHaveFood[tile_idx];
-		s_perceivedMap[tile_idx].m_lastUpdated = g_turnState.turnNumber;
+	//the queen's start is only known once she reports, the farthest tiles once there are tables to measure
+	ClearLandmarks();
+	s_landmarkAnchor[0] = IntVec2::NEG_ONE;
+	s_landmarkAnchor[1] = IntVec2(0, 0);
+	s_landmarkAnchor[2] = IntVec2(width - 1, 0);
+	s_landmarkAnchor[3] = IntVec2(0, width - 1);
+	s_landmarkAnchor[4] = IntVec2(width - 1, width - 1);
+	for(int slot_idx = NUM_FIXED_LANDMARKS; slot_idx < MAX_LANDMARKS; ++slot_idx)
+	{
+		s_landmarkAnchor[slot_idx] = IntVec2::NEG_ONE;
 	}
 
-	s_enemyLoc.clear();
-	if(g_turnState.numObservedAgents > 0)
+	//one bit per eNeighborDir, set when that neighbor is on the map
+	for(int y_idx = 0; y_idx < width; ++y_idx)
 	{
-		for(int enemy_num = 0; enemy_num < g_turnState.numObservedAgents; ++enemy_num)
+		for(int x_idx = 0; x_idx < width; ++x_idx)
 		{
-			ObservedAgent enemy = g_turnState.observedAgents[enemy_num];
-			if (enemy.type == AGENT_TYPE_SCOUT) continue;
-			IntVec2 enemy_coord(enemy.tileX, enemy.tileY);
-			s_enemyLoc.push_back(GetTileIndex(enemy_coord));
+			const bool has_east = x_idx + 1 < width;
+			const bool has_north = y_idx + 1 < width;
+			const bool has_west = x_idx > 0;
+			const bool has_south = y_idx > 0;
+
+			unsigned char mask = 0;
+			if(has_east)				mask |= 1 << NEIGHBOR_EAST;
+			if(has_north)				mask |= 1 << NEIGHBOR_NORTH;
+			if(has_west)				mask |= 1 << NEIGHBOR_WEST;
+			if(has_south)				mask |= 1 << NEIGHBOR_SOUTH;
+			if(has_north && has_east)	mask |= 1 << NEIGHBOR_NORTH_EAST;
+			if(has_north && has_west)	mask |= 1 << NEIGHBOR_NORTH_WEST;
+			if(has_south && has_west)	mask |= 1 << NEIGHBOR_SOUTH_WEST;
+			if(has_south && has_east)	mask |= 1 << NEIGHBOR_SOUTH_EAST;
+
+			s_neighborMask[y_idx * width + x_idx] = mask;
 		}
 	}
 }
 
-IntVec2 Geographer::AddAntToFoodTile(AgentID ant)
+
+//claims the unclaimed food closest to the ant by walking cost, it stops being a source
+//so the next ant is sent somewhere else
+IntVec2 Geographer::AddAntToFoodTile(AgentID ant, const IntVec2& ant_coord)
 {
-	if(s_foodLoc.empty()) return IntVec2(-1, -1);
+	if(s_numFoodSources == 0 || !IsValidCoord(ant_coord)) return IntVec2(-1, -1);
+
+	const int food_idx = s_foodSource[GetTileIndex(ant_coord)];
+	if(food_idx < 0) return IntVec2(-1, -1);
 
-	short food_idx = s_foodLoc.back();
-	s_foodLoc.pop_back();
-	s_perceivedMap[food_idx].m_goingToThisTile = ant;
+	s_foodClaims[food_idx] = ant;
+	s_foodFieldRemoved.push_back(food_idx);
+	UpdateFoodField();
 	return GetTileCoord(food_idx);
 }
 
 void Geographer::RemoveAntFromFoodTile(IntVec2 coord)
 {
-	short food_idx = GetTileIndex(coord);
-	s_perceivedMap[food_idx].m_goingToThisTile = UINT_MAX;
+	if(!IsValidCoord(coord)) return;
+
+	int food_idx = GetTileIndex(coord);
+	s_foodClaims.erase(food_idx);
+
+	if(DoesTileHaveFood(food_idx))
+	{
+		s_foodFieldAdded.push_back(food_idx);
+		UpdateFoodField();
+	}
 }
 
 //--------------------------------------------------------------------------
 // Helper functions
 
 
-STATIC short Geographer::GetTileIndex(const IntVec2& coord)
+STATIC int Geographer::GetTileIndex(const IntVec2& coord)
 {
-	return static_cast<short>(coord.y * s_mapDimensions + coord.x); 
+	return coord.y * s_mapDimensions + coord.x; 
 }
 
 STATIC float Geographer::ManhattanHeuristic(const IntVec2& start, const IntVec2& end)
@@ -447,6 +485,7 @@ STATIC float Geographer::ManhattanHeuristic(const IntVec2& start, const IntVec2&
 	return dx + dy;
 }
 
+
 float Geographer::OctileDistance(const IntVec2& start, const IntVec2& end)
 {	
 	float dx = static_cast<float>(Abs(start.x - end.x));
@@ -460,11 +499,203 @@ float Geographer::EuclideanHeuristic(const IntVec2& start, const IntVec2& end)
 		(end.y - start.y) * (end.y - start.y)));
 }
 
+PathingScratch::PathingScratch()
+	: m_pathingMap(MAX_ARENA_TILES)
+	, m_reversePathingMap(MAX_ARENA_TILES)
+	, m_openList(MAX_ARENA_TILES, MAX_ARENA_TILES)
+	, m_reverseOpenList(MAX_ARENA_TILES, MAX_ARENA_TILES)
+	, m_bucketOpenList(MAX_ARENA_TILES)
+{
+}
+
+//every search on this thread reads and writes the bound scratch until another is bound
+STATIC void Geographer::BindPathingScratch(PathingScratch* scratch)
+{
+	s_scratch = scratch;
+}
+
+//starting a new search generation marks every node stale, so nothing is copied per search
 STATIC void Geographer::ResetPathingMap()
 {
-	memcpy(s_pathingMap, DEFAULT_PATHING_MAP, MAX_ARENA_TILES * sizeof(NodeRecord));
+	++s_scratch->m_pathingGeneration;
+
+	//wrapped around, old stamps could match again so do the full clear once
+	if(s_scratch->m_pathingGeneration == 0)
+	{
+		for(int node_idx = 0; node_idx < MAX_ARENA_TILES; ++node_idx)
+		{
+			s_scratch->m_pathingMap[node_idx] = NodeRecord();
+			s_scratch->m_reversePathingMap[node_idx] = NodeRecord();
+		}
+
+		s_scratch->m_pathingGeneration = 1;
+	}
+}
+
+STATIC NodeRecord& Geographer::GetPathingNode(const int tile_index)
+{
+	NodeRecord& node = s_scratch->m_pathingMap[tile_index];
+	if(node.m_generation != s_scratch->m_pathingGeneration)
+	{
+		node = NodeRecord();
+		node.m_generation = s_scratch->m_pathingGeneration;
+	}
+
+	return node;
+}
+
+STATIC NodeRecord& Geographer::GetReversePathingNode(const int tile_index)
+{
+	NodeRecord& node = s_scratch->m_reversePathingMap[tile_index];
+	if(node.m_generation != s_scratch->m_pathingGeneration)
+	{
+		node = NodeRecord();
+		node.m_generation = s_scratch->m_pathingGeneration;
+	}
+
+	return node;
+}
+
+STATIC bool Geographer::IsPathingNodeStale(const int tile_index)
+{
+	return s_scratch->m_pathingMap[tile_index].m_generation != s_scratch->m_pathingGeneration;
+}
+
+//one tile's perceived state in the old single record, for callers that want it all together
+STATIC TileRecord Geographer::GetTileRecord(const int tile_index)
+{
+	TileRecord tile_record;
+	tile_record.m_tileType = s_perceivedTypes[tile_index];
+	tile_record.m_hasFood = DoesTileHaveFood(tile_index);
+	tile_record.m_lastUpdated = s_lastSeenTurn[tile_index];
+	tile_record.m_goingToThisTile = GetFoodClaim(tile_index);
+	return tile_record;
+}
+
+//the server's move exhaust for every agent type, plus the per move carry cost. Stone is a wall
+//for everyone and water kills whoever steps in, so both are walls. A tile the type can not walk
+//into but can dig costs, empty handed, the turn spent digging, the dig exhaust and the move onto
+//the air it leaves, so every search weighs digging through against walking around the same way.
+//Unseen tiles are hoped to be air
+STATIC void Geographer::BuildCostTables()
+{
+	for(int type_idx = 0; type_idx < NUM_AGENT_TYPES; ++type_idx)
+	{
+		const AgentTypeInfo& type_info = g_matchInfo.agentTypeInfos[type_idx];
+		const int air_move_penalty = type_info.moveExhaustPenalties[TILE_TYPE_AIR];
+
+		for(int carry_idx = 0; carry_idx < NUM_CARRY_STATES; ++carry_idx)
+		{
+			float carry_penalty = 0.0f;
+			if(carry_idx == CARRY_FOOD)			carry_penalty = static_cast<float>(g_matchInfo.foodCarryExhaustPenalty);
+			else if(carry_idx == CARRY_TILE)	carry_penalty = static_cast<float>(g_matchInfo.tileCarryExhaustPenalty);
+
+			float* exhaust_table = s_exhaustPenalty[type_idx][carry_idx];
+			for(int tile_value = 0; tile_value < NUM_TILE_TYPE_VALUES; ++tile_value)
+			{
+				exhaust_table[tile_value] = carry_penalty;
+			}
+
+			for(int tile_idx = 0; tile_idx < NUM_TILE_TYPES; ++tile_idx)
+			{
+				const int move_penalty = type_info.moveExhaustPenalties[tile_idx];
+				exhaust_table[tile_idx] = move_penalty == TILE_IMPASSABLE ? IMPASSABLE_PENALTY : 
+					static_cast<float>(move_penalty) + carry_penalty;
+			}
+
+			exhaust_table[TILE_TYPE_STONE] = IMPASSABLE_PENALTY;
+			exhaust_table[TILE_TYPE_WATER] = IMPASSABLE_PENALTY;
+		}
+
+		for(int tile_value = 0; tile_value < NUM_TILE_TYPE_VALUES; ++tile_value)
+		{
+			s_mustDigToEnter[type_idx][tile_value] = false;
+		}
+
+		//a corpse bridge dug out turns back into water, only dirt is worth digging through
+		const int dig_penalty = type_info.digExhaustPenalties[TILE_TYPE_DIRT];
+		if(dig_penalty == DIG_IMPOSSIBLE || air_move_penalty == TILE_IMPASSABLE) continue;
+
+		float* empty_handed_table = s_exhaustPenalty[type_idx][CARRY_NOTHING];
+		const float dig_through_penalty = 1.0f + static_cast<float>(dig_penalty + air_move_penalty);
+		if(dig_through_penalty < empty_handed_table[TILE_TYPE_DIRT])
+		{
+			empty_handed_table[TILE_TYPE_DIRT] = dig_through_penalty;
+			s_mustDigToEnter[type_idx][TILE_TYPE_DIRT] = true;
+		}
+	}
+
+	//which tiles count as open follows the costs
+	s_jumpTableDirty = true;
+}
+
+
+//the shared tables a search would otherwise rebuild on demand are brought up to date first,
+//so while the batch runs on every player thread the searches only read shared state
+STATIC void Geographer::PrepareForPathingBatch(const ePathingStrategy strategy)
+{
+	switch(strategy)
+	{
+	case PATHING_JUMP_POINT:
+		{
+			if(s_jumpTableDirty) RebuildJumpTable();
+			break;
+		}
+	case PATHING_ANYTIME:
+	case PATHING_INCREMENTAL:	//a one off Pathfind under these strategies runs HPA*
+	case PATHING_HIERARCHICAL:
+		{
+			UpdateHierarchy(false);
+			UpdateHierarchy(true);
+			break;
+		}
+	default:
+		break;
+	}
+}
+
+
+//the searches that only split workers from everyone else read the worker and soldier rows
+STATIC float Geographer::GetExhaustPenalty(const eTileType tile_type, const bool for_worker)
+{
+	const eAgentType agent_type = for_worker ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	return s_exhaustPenalty[agent_type][CARRY_NOTHING][tile_type];
+}
+
+
+STATIC float Geographer::GetExhaustPenalty(const eTileType tile_type, const eAgentType agent_type, 
+	const eCarryState carry_state)
+{
+	return s_exhaustPenalty[agent_type][carry_state][tile_type];
+}
+
+
+//the dearest tile the agent can still walk onto
+STATIC float Geographer::GetMaxExhaustPenalty(const eAgentType agent_type, const eCarryState carry_state)
+{
+	const float* exhaust_table = s_exhaustPenalty[agent_type][carry_state];
+
+	float max_penalty = 0.0f;
+	for(int tile_value = 0; tile_value < NUM_TILE_TYPE_VALUES; ++tile_value)
+	{
+		if(exhaust_table[tile_value] < IMPASSABLE_PENALTY) max_penalty = Max(max_penalty, exhaust_table[tile_value]);
+	}
+
+	return max_penalty;
 }
 
+//ORDER_HOLD when the two tiles are not side by side
+STATIC eOrderCode Geographer::GetNeighborMoveOrder(const int from_index, const int to_index)
+{
+	for(NeighborIterator neighbor(from_index); neighbor.IsValid(); neighbor.Next())
+	{
+		if(neighbor.GetTileIndex() == to_index) return neighbor.GetMoveOrder();
+	}
+
+	return ORDER_HOLD;
+}
+
+
 STATIC void Geographer::GetCenteredSquareDis(std::vector<IntVec2>& out_coords, int depth, bool just_edge)
 {
 	if(just_edge)
@@ -559,7 +790,7 @@ STATIC int Geographer::GetCenteredSquareCount(int depth, bool just_edge)
 }
 
 
-STATIC IntVec2 Geographer::GetTileCoord(const short tile_index)
+STATIC IntVec2 Geographer::GetTileCoord(const int tile_index)
 {
 	IntVec2 coord;
 	coord.x = tile_index % s_mapDimensions;
@@ -611,6 +842,18 @@ STATIC IntVec2 Geographer::GetCoordFromCardDir(const eOrderCode dir, const IntVe
 }
 
 
+STATIC bool Geographer::IsWalkableTile(const int tile_index, const bool for_worker)
+{
+	return GetExhaustPenalty(s_perceivedTypes[tile_index], for_worker) < IMPASSABLE_PENALTY;
+}
+
+
+STATIC bool Geographer::IsWalkableTile(const int tile_index, const eAgentType agent_type, const eCarryState carry_state)
+{
+	return GetExhaustPenalty(s_perceivedTypes[tile_index], agent_type, carry_state) < IMPASSABLE_PENALTY;
+}
+
+
 //--------------------------------------------------------------------------
 // Debug Drawing
 
@@ -698,14 +941,14 @@ void Geographer::DebugPrintCostMap()
 {
 	for (int node_idx = 0; node_idx < s_mapTotalSize; ++node_idx)
 	{
-		if(s_pathingMap[node_idx].m_nodeState == NodeRecord::UNVISITED)
+		if(IsPathingNodeStale(node_idx) || s_scratch->m_pathingMap[node_idx].m_nodeState == NodeRecord::UNVISITED)
 		{
 			continue;
 		}
 
-		const int cost = static_cast<int>(s_pathingMap[node_idx].m_pathCost);
+		const int cost = static_cast<int>(s_scratch->m_pathingMap[node_idx].m_pathCost);
 		std::string cost_string	= std::to_string(cost);
-		const IntVec2 pos = s_pathingMap[node_idx].m_coord;
+		const IntVec2 pos = s_scratch->m_pathingMap[node_idx].m_coord;
 		const float x_coord = static_cast<float>(pos.x);
 		const float y_coord = static_cast<float>(pos.y);
 		g_debugInterface->QueueDrawWorldText(x_coord, y_coord, 0.5f, 0.5f, 0.8f, Color8(255, 255, 255), cost_string.c_str());
@@ -718,7 +961,9 @@ void Geographer::DebugPrintDirectionMap()
 {
 	for (int node_idx = 0; node_idx < s_mapTotalSize; ++node_idx)
 	{
-		eOrderCode action = s_pathingMap[node_idx].m_actionTook;
+		if(IsPathingNodeStale(node_idx)) continue;
+
+		eOrderCode action = s_scratch->m_pathingMap[node_idx].m_actionTook;
 		std::string dir_string;
 
 		switch(action)
@@ -745,7 +990,7 @@ void Geographer::DebugPrintDirectionMap()
 		}
 		}
 
-		const IntVec2 pos = s_pathingMap[node_idx].m_coord;
+		const IntVec2 pos = s_scratch->m_pathingMap[node_idx].m_coord;
 		const float x_coord = static_cast<float>(pos.x);
 		const float y_coord = static_cast<float>(pos.y);
 		g_debugInterface->QueueDrawWorldText(x_coord, y_coord, 0.5f, 0.5f, 1.0f, Color8(255, 255, 255), dir_string.c_str());
@@ -764,7 +1009,7 @@ void Geographer::DebugPrintPath(const IntVec2& start, const IntVec2& end)
 		const float y_coord = static_cast<float>(current_coord.y);
 		g_debugInterface->QueueDrawWorldText(x_coord, y_coord, 0.5f, 0.5f, 0.8f, Color8(255, 255, 255), "@");
 
-		eOrderCode action_took = s_pathingMap[GetTileIndex(current_coord)].m_actionTook;
+		eOrderCode action_took = s_scratch->m_pathingMap[GetTileIndex(current_coord)].m_actionTook;
 		current_coord = GetCoordFromCardDir(action_took, current_coord, true);
 	}while(current_coord != start);
 
@@ -826,7 +1071,7 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 		return order_list;
 	}
 
-	const short start_idx = GetTileIndex(start);
+	const int start_idx = GetTileIndex(start);
 
 	//Map representation for node records
 	NodeRecord* map = new NodeRecord[s_mapTotalSize];
@@ -838,14 +1083,14 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 	map[start_idx].m_pathCost = 0;
 	map[start_idx].m_nodeState = NodeRecord::OPEN;
 
-	MinHeap<NodePriority> frontier(s_mapTotalSize);
-	frontier.Push(NodePriority(start_idx, map[start_idx].m_pathCost));
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(start_idx, NodePriority(start_idx, map[start_idx].m_pathCost));
 
 	NodeRecord current_node;
-	while(frontier.GetSize() > 0)
+	while(s_scratch->m_openList.GetSize() > 0)
 	{
-		const NodePriority priority_node = frontier.Pop();
-		const short current_idx = priority_node.m_idx;
+		const NodePriority priority_node = s_scratch->m_openList.Pop();
+		const int current_idx = priority_node.m_idx;
 		current_node = map[current_idx];
 		
 		if((current_node.m_coord == end))
@@ -854,19 +1099,16 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 			break;
 		}
 
-		std::vector<IntVec2> connections = FourNeighbors(map[current_idx].m_coord);
-		for(int con_idx = 0; con_idx < static_cast<int>(connections.size()); ++con_idx)
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
 		{
-			//GetNeighbors will always return 4 elements, if invalid it returns (-1,-1)
-			if(connections[con_idx] == IntVec2(-1, -1)) continue;
-			
+			const int new_node_idx = neighbor.GetTileIndex();
+
 			NodeRecord new_node;
-			new_node.m_coord = connections[con_idx];
-			new_node.m_parentIdx = GetTileIndex(current_node.m_coord);
-			new_node.m_actionTook = static_cast<eOrderCode>(con_idx + 1);
+			new_node.m_coord = neighbor.GetCoord(current_node.m_coord);
+			new_node.m_parentIdx = current_idx;
+			new_node.m_actionTook = neighbor.GetMoveOrder();
 			new_node.m_pathCost = static_cast<float>(current_node.m_pathCost + 1);
 			
-			const short new_node_idx = GetTileIndex(new_node.m_coord);
 			bool update_open_list = false;
 			
 			//if the node is in the closed list, then we can skip
@@ -887,14 +1129,11 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 			// we either have an unvisited node, or need to updated a node
 			if(!update_open_list) // most likely
 			{
-				frontier.Push(NodePriority(new_node_idx, new_node.m_pathCost));
+				s_scratch->m_openList.Push(new_node_idx, NodePriority(new_node_idx, new_node.m_pathCost));
 			}
 			else //Update node with new value
 			{
-				//this is linear time, make sure we really need to do this
-				const int frontier_idx = frontier.GetIndex(NodePriority(new_node_idx, new_node.m_pathCost));
-				if(frontier_idx == -1) break;
-				frontier.UpdateAtIdx(frontier_idx, NodePriority(new_node_idx, new_node.m_pathCost));
+				s_scratch->m_openList.DecreaseKey(new_node_idx, NodePriority(new_node_idx, new_node.m_pathCost));
 			}
 
 			map[new_node_idx].m_coord = new_node.m_coord;
@@ -915,7 +1154,7 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 	}
 	else
 	{
-		short current_idx = GetTileIndex(current_node.m_coord);
+		int current_idx = GetTileIndex(current_node.m_coord);
 
 		//pushing back coord, need to reverse
 		while(current_idx != start_idx)
@@ -936,9 +1175,104 @@ STATIC std::vector<eOrderCode> Geographer::PathfindDijkstra( const IntVec2& star
 	return order_list;
 }
 
+//Gives the heap and the bucket queue the same small interface, so A* is only written once.
+//Bucket priorities are fixed point, one bucket per tie break slot, so a bucket holds exactly
+//the nodes the heap would see as equal
+constexpr float BUCKET_PRIORITY_SCALE = static_cast<float>(SEARCH_TIE_BREAK_SLOTS);
+
+struct HeapOpenList
+{
+	explicit HeapOpenList(IndexedMinHeap<NodePriority>& heap): m_heap(heap) {}
+
+	void	Clear()											{ m_heap.Clear(); }
+	int		GetSize() const									{ return m_heap.GetSize(); }
+	bool	Contains(const int idx) const					{ return m_heap.Contains(idx); }
+	void	Push(const int idx, const float pri)			{ m_heap.Push(idx, NodePriority(idx, pri)); }
+	void	DecreaseKey(const int idx, const float pri)		{ m_heap.DecreaseKey(idx, NodePriority(idx, pri)); }
+	int		Pop()											{ return m_heap.Pop().m_idx; }
+
+	IndexedMinHeap<NodePriority>& m_heap;
+};
+
+struct BucketOpenList
+{
+	explicit BucketOpenList(BucketQueue& buckets): m_buckets(buckets) {}
+
+	void	Clear()											{ m_buckets.Clear(); }
+	int		GetSize() const									{ return m_buckets.GetSize(); }
+	bool	Contains(const int idx) const					{ return m_buckets.Contains(idx); }
+	void	Push(const int idx, const float pri)			{ m_buckets.Push(idx, ToBucketPriority(pri)); }
+	void	DecreaseKey(const int idx, const float pri)		{ m_buckets.DecreaseKey(idx, ToBucketPriority(pri)); }
+	int		Pop()											{ return m_buckets.Pop(); }
+
+	static int ToBucketPriority(const float pri)	{ return static_cast<int>(pri * BUCKET_PRIORITY_SCALE + 0.5f); }
+
+	BucketQueue&	m_buckets;
+};
+
+
+STATIC std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const IntVec2& end, bool for_worker, 
+	eQueueType open_list_type)
+{
+	const eAgentType agent_type = for_worker ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	return PathfindAstar(start, end, agent_type, CARRY_NOTHING, open_list_type);
+}
+
+
+STATIC std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const IntVec2& end, eAgentType agent_type,
+	eCarryState carry_state, eQueueType open_list_type)
+{
+	//the heuristic moves at most one per step, so every queued f sits within the dearest step plus
+	//one of the lowest. When that spread fits the window nothing is ever clamped, otherwise the
+	//heap runs the search from the start
+	const float max_step_cost = 1.0f + GetMaxExhaustPenalty(agent_type, carry_state);
+	const bool fits_bucket_window = (max_step_cost + 3.0f) * BUCKET_PRIORITY_SCALE <= BucketQueue::NUM_BUCKETS;
+	if(open_list_type == QUEUE_BUCKET && fits_bucket_window)
+	{
+		BucketOpenList bucket_list(s_scratch->m_bucketOpenList);
+		return PathfindAstarForAgent(bucket_list, start, end, agent_type, carry_state);
+	}
+
+	HeapOpenList heap_list(s_scratch->m_openList);
+	return PathfindAstarForAgent(heap_list, start, end, agent_type, carry_state);
+}
+
+
+template <typename OpenList>
+STATIC std::vector<eOrderCode> Geographer::PathfindAstarForAgent(OpenList& open_list, const IntVec2& start, const IntVec2& end,
+	const eAgentType agent_type, const eCarryState carry_state)
+{
+	switch(agent_type)
+	{
+	case AGENT_TYPE_SCOUT:		return PathfindAstarForCarry<AGENT_TYPE_SCOUT>(open_list, start, end, carry_state);
+	case AGENT_TYPE_SOLDIER:	return PathfindAstarForCarry<AGENT_TYPE_SOLDIER>(open_list, start, end, carry_state);
+	case AGENT_TYPE_QUEEN:		return PathfindAstarForCarry<AGENT_TYPE_QUEEN>(open_list, start, end, carry_state);
+	case AGENT_TYPE_WORKER:
+	default:					return PathfindAstarForCarry<AGENT_TYPE_WORKER>(open_list, start, end, carry_state);
+	}
+}
+
+
+template <eAgentType AGENT_TYPE, typename OpenList>
+STATIC std::vector<eOrderCode> Geographer::PathfindAstarForCarry(OpenList& open_list, const IntVec2& start, const IntVec2& end,
+	const eCarryState carry_state)
+{
+	switch(carry_state)
+	{
+	case CARRY_FOOD:	return PathfindAstar<AGENT_TYPE, CARRY_FOOD>(open_list, start, end);
+	case CARRY_TILE:	return PathfindAstar<AGENT_TYPE, CARRY_TILE>(open_list, start, end);
+	case CARRY_NOTHING:
+	default:			return PathfindAstar<AGENT_TYPE, CARRY_NOTHING>(open_list, start, end);
+	}
+}
+
+
 //I don't like copy and past, however, I don't believe I will ever use Dijkstra again
-std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const IntVec2& end, bool for_worker)
+template <eAgentType AGENT_TYPE, eCarryState CARRY_STATE, typename OpenList>
+STATIC std::vector<eOrderCode> Geographer::PathfindAstar(OpenList& open_list, const IntVec2& start, const IntVec2& end)
 {
+	const float* exhaust_table = s_exhaustPenalty[AGENT_TYPE][CARRY_STATE];
+
 	std::vector<eOrderCode> order_list;
 	if(start == end) //redundent check
 	{
@@ -946,111 +1280,91 @@ std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const In
 		return order_list;
 	}
 
-	const short start_idx = GetTileIndex(start);
-	int max_expansions = s_mapDimensions * 2;
+	const int start_idx = GetTileIndex(start);
+	const int end_idx = GetTileIndex(end);
+	int max_expansions = s_mapDimensions * 16;	//a least cost search settles far more tiles than a greedy one
 	int num_expansion = 0;
 	
 	//Setup root node
-	s_pathingMap[start_idx].m_coord = start;
-	s_pathingMap[start_idx].m_parentIdx = -1;
-	s_pathingMap[start_idx].m_actionTook = ORDER_HOLD;
-	s_pathingMap[start_idx].m_pathCost = 0;
-	s_pathingMap[start_idx].m_heuristic =  ManhattanHeuristic(start, end);
-	s_pathingMap[start_idx].m_nodeState = NodeRecord::OPEN;
+	NodeRecord& root_node = GetPathingNode(start_idx);
+	root_node.m_coord = start;
+	root_node.m_parentIdx = -1;
+	root_node.m_actionTook = ORDER_HOLD;
+	root_node.m_pathCost = 0;
+	root_node.m_heuristic =  LandmarkHeuristic(start_idx, end_idx);
+	root_node.m_nodeState = NodeRecord::OPEN;
 
-	MinHeap<NodePriority> frontier(s_mapTotalSize);
-	frontier.Push(NodePriority(start_idx, s_pathingMap[start_idx].m_pathCost));
+	open_list.Clear();
+	open_list.Push(start_idx, root_node.m_pathCost);
 
 	NodeRecord current_node;
-	while(frontier.GetSize() > 0)
+	while(open_list.GetSize() > 0)
 	{
-		const NodePriority priority_node = frontier.Pop();
-		const short current_idx = priority_node.m_idx;
-		current_node = s_pathingMap[current_idx];
+		const int current_idx = open_list.Pop();
+		current_node = GetPathingNode(current_idx);
 
 		++num_expansion;
 		if((current_node.m_coord == end) || num_expansion == max_expansions)	break;
 
-		std::vector<IntVec2> connections = FourNeighbors(current_node.m_coord);
-		for(int con_idx = 0; con_idx < static_cast<int>(connections.size()); ++con_idx)
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
 		{
-			//GetNeighbors will always return 4 elements, if invalid it returns (-1,-1)
-			if(connections[con_idx] == IntVec2(-1, -1)) continue;
+			const int new_node_idx = neighbor.GetTileIndex();
+
+			//walls are skipped the way IsWalkableTile does, so every search shares one passability model
+			const float exhaust_penalty = exhaust_table[s_perceivedTypes[new_node_idx]];
+			if(exhaust_penalty >= IMPASSABLE_PENALTY) continue;
 
 			NodeRecord new_node;
-			new_node.m_coord = connections[con_idx];
-			new_node.m_parentIdx = GetTileIndex(current_node.m_coord);
-			new_node.m_actionTook = static_cast<eOrderCode>(con_idx + 1);
-			new_node.m_heuristic = ManhattanHeuristic(new_node.m_coord, end) +
-				0.03f * OctileDistance(new_node.m_coord, end);
-
-			float exhaust_penalty = 0.0f;
-			switch (s_perceivedMap[GetTileIndex(new_node.m_coord)].m_tileType)
-			{
-			case TILE_TYPE_AIR:
-				exhaust_penalty = 0.0f;
-				break;
-			case TILE_TYPE_STONE:
-				exhaust_penalty = 1000.0f;
-				break;
-			case TILE_TYPE_WATER:
-				if (for_worker)
-					exhaust_penalty = 2.0f;
-				else
-					exhaust_penalty = 1000.0f;
-				break;
-			case TILE_TYPE_CORPSE_BRIDGE:
-				exhaust_penalty = 0.0f;
-				break;
-			case TILE_TYPE_DIRT:
-				if (for_worker)
-					exhaust_penalty = 1.0f;
-				else
-					exhaust_penalty = 1000.0f;
-			break;
-			}
-			
-			
-			new_node.m_pathCost = current_node.m_pathCost + exhaust_penalty;
-			
-			const short new_node_idx = GetTileIndex(new_node.m_coord);
+			new_node.m_coord = neighbor.GetCoord(current_node.m_coord);
+			new_node.m_parentIdx = current_idx;
+			new_node.m_actionTook = neighbor.GetMoveOrder();
+			new_node.m_heuristic = LandmarkHeuristic(new_node_idx, end_idx);
+
+			//a step costs the turn it takes plus its exhaust, like every other search, so a detour
+			//through free air is still weighed by its length against digging through
+			new_node.m_pathCost = current_node.m_pathCost + 1.0f + exhaust_penalty;
 
 			//if the node is in the closed list, then we may skip or remove it from the closed list
-			switch(s_pathingMap[new_node_idx].m_nodeState)
+			NodeRecord& neighbor_record = GetPathingNode(new_node_idx);
+			switch(neighbor_record.m_nodeState)
 			{
 			case NodeRecord::CLOSED:
 			case NodeRecord::OPEN:
 				{
 					// need to know if the node in the open list is better or worse
 					//if the node in the list is better, we can skip it
-					if(s_pathingMap[new_node_idx].m_pathCost <= new_node.m_pathCost) continue;
+					if(neighbor_record.m_pathCost <= new_node.m_pathCost) continue;
 
 					// if our new node is better, highly unlikely but, we need to update
-					// the node in the list with the lower cost, and the action we took
-					// this is linear time, make sure we really need to do this
-					const int frontier_idx = frontier.GetIndex(NodePriority(new_node_idx, new_node.m_pathCost));
-					if(frontier_idx == -1) break;
-					frontier.UpdateAtIdx(frontier_idx, NodePriority(new_node_idx, new_node.m_pathCost + new_node.m_heuristic));
+					// the node in the list with the lower cost, and the action we took.
+					// a closed node is no longer in the heap, so it gets reopened instead
+					const float better_priority = GetSearchPriority(new_node.m_pathCost, new_node.m_heuristic);
+					if(open_list.Contains(new_node_idx))
+						open_list.DecreaseKey(new_node_idx, better_priority);
+					else
+						open_list.Push(new_node_idx, better_priority);
 					break;
 				}
 			case NodeRecord::UNVISITED:
 				{
-					frontier.Push(NodePriority(new_node_idx, new_node.m_pathCost + new_node.m_heuristic));
+					open_list.Push(new_node_idx, GetSearchPriority(new_node.m_pathCost, new_node.m_heuristic));
 					break;
 				}
 			}
 
-			s_pathingMap[new_node_idx].m_coord = new_node.m_coord;
-			s_pathingMap[new_node_idx].m_parentIdx = new_node.m_parentIdx;
-			s_pathingMap[new_node_idx].m_actionTook = new_node.m_actionTook;
-			s_pathingMap[new_node_idx].m_pathCost = new_node.m_pathCost;
-			s_pathingMap[new_node_idx].m_nodeState = NodeRecord::OPEN;
+			neighbor_record.m_coord = new_node.m_coord;
+			neighbor_record.m_parentIdx = new_node.m_parentIdx;
+			neighbor_record.m_actionTook = new_node.m_actionTook;
+			neighbor_record.m_pathCost = new_node.m_pathCost;
+			neighbor_record.m_nodeState = NodeRecord::OPEN;
 		}
 
 		//Finished looking at all connections,
-		s_pathingMap[current_idx].m_nodeState = NodeRecord::CLOSED;
+		GetPathingNode(current_idx).m_nodeState = NodeRecord::CLOSED;
 	}
 
+	s_scratch->m_lastNumExpansions = num_expansion;
+
 	//Either found the goal, or exhausted the open list
 	if(current_node.m_coord != end)
 	{
@@ -1058,14 +1372,14 @@ std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const In
 	}
 	else
 	{
-		short current_idx = GetTileIndex(current_node.m_coord);
+		int current_idx = GetTileIndex(current_node.m_coord);
 
 		//pushing back coord, need to reverse
 		while(current_idx != start_idx)
 		{
-			eOrderCode action_took = s_pathingMap[current_idx].m_actionTook;
-			order_list.push_back(action_took);
-			current_idx = s_pathingMap[current_idx].m_parentIdx;
+			const NodeRecord& path_node = GetPathingNode(current_idx);
+			order_list.push_back(path_node.m_actionTook);
+			current_idx = path_node.m_parentIdx;
 		}
 
 		std::reverse(order_list.begin(),order_list.end());
@@ -1078,3 +1392,493 @@ std::vector<eOrderCode> Geographer::PathfindAstar(const IntVec2& start, const In
 	ResetPathingMap();
 	return order_list;
 }
+
+
+//a route asked for again is a hash lookup while the clusters it crosses are unchanged,
+//a shortcut that opens somewhere else is only found once the route is dropped
+STATIC std::vector<eOrderCode> Geographer::Pathfind(const IntVec2& start, const IntVec2& end, bool for_worker, 
+	ePathingStrategy strategy)
+{
+	std::vector<eOrderCode> order_list;
+	if(start == end || !IsReachable(start, end, for_worker))
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	const unsigned long long cache_key = GetPathCacheKey(GetTileIndex(start), GetTileIndex(end), for_worker, strategy);
+	if(FindCachedPath(order_list, cache_key)) return order_list;
+
+	switch(strategy)
+	{
+	case PATHING_JUMP_POINT:	order_list = PathfindJumpPoint(start, end, for_worker);		break;
+	case PATHING_BIDIRECTIONAL:	order_list = PathfindBidirectional(start, end, for_worker);	break;
+	case PATHING_ANYTIME:		//the resumable search lives on each ant, a one off request runs HPA* to the end
+	case PATHING_INCREMENTAL:	//the D* Lite state lives on each ant, a one off request falls back to HPA*
+	case PATHING_HIERARCHICAL:	order_list = PathfindHierarchical(start, end, for_worker);	break;
+	case PATHING_ASTAR:
+	default:					order_list = PathfindAstar(start, end, for_worker);			break;
+	}
+
+	CachePath(cache_key, start, order_list);
+	return order_list;
+}
+
+
+//Jump point search on the four way grid (horizontal runs first, then vertical, like JPS4).
+//Only open tiles, the ones that cost the ant what air does, are jumped across. Everything dearer
+//is stepped into one tile at a time like plain A*, and any open tile touching one is a jump point
+//so the search can always turn into it. Runs are read from the JPS+ table, so a jump is O(1).
+//Each node keeps the move it was reached with, the run back to its parent is expanded into
+//single moves when the path is built.
+STATIC std::vector<eOrderCode> Geographer::PathfindJumpPoint(const IntVec2& start, const IntVec2& end, bool for_worker)
+{
+	std::vector<eOrderCode> order_list;
+	if(start == end)
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	const int start_idx = GetTileIndex(start);
+	const int end_idx = GetTileIndex(end);
+	int max_expansions = s_mapDimensions * 16;
+	int num_expansion = 0;
+
+	if(s_jumpTableDirty) RebuildJumpTable();
+
+	//Setup root node
+	NodeRecord& root_node = GetPathingNode(start_idx);
+	root_node.m_coord = start;
+	root_node.m_parentIdx = -1;
+	root_node.m_actionTook = ORDER_HOLD;
+	root_node.m_pathCost = 0;
+	root_node.m_heuristic =  LandmarkHeuristic(start_idx, end_idx);
+	root_node.m_nodeState = NodeRecord::OPEN;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(start_idx, NodePriority(start_idx, root_node.m_pathCost));
+
+	NodeRecord current_node;
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_idx = s_scratch->m_openList.Pop().m_idx;
+		current_node = GetPathingNode(current_idx);
+
+		++num_expansion;
+		if(current_idx == end_idx || num_expansion == max_expansions)	break;
+
+		//the root, costly tiles and the open tiles beside them look every way,
+		//anywhere else only the directions that can start a shorter run
+		const bool arrived = current_node.m_actionTook != ORDER_HOLD;
+		const eNeighborDir arrived_dir = static_cast<eNeighborDir>(current_node.m_actionTook - ORDER_MOVE_EAST);
+		const bool look_every_way = !arrived || !IsOpenTile(current_idx, for_worker) || HasCostlyNeighbor(current_idx, for_worker);
+		const bool arrived_vertically = arrived_dir == NEIGHBOR_NORTH || arrived_dir == NEIGHBOR_SOUTH;
+
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const eNeighborDir dir = neighbor.GetDir();
+			if(arrived && dir == (arrived_dir + 2) % NUM_CARDINAL_DIRS) continue;
+
+			if(!look_every_way && arrived_vertically && dir != arrived_dir)
+			{
+				const int prev_idx = current_idx - s_neighborOffsets[arrived_dir];
+				if(!IsForcedSide(prev_idx, current_idx, dir, for_worker)) continue;
+			}
+
+			int new_node_idx = neighbor.GetTileIndex();
+			if(IsOpenTile(new_node_idx, for_worker))
+			{
+				new_node_idx = Jump(current_idx, dir, end_idx, for_worker);
+				if(new_node_idx < 0) continue;
+			}
+			else if(!IsWalkableTile(new_node_idx, for_worker))
+			{
+				continue;
+			}
+
+			NodeRecord new_node;
+			new_node.m_coord = GetTileCoord(new_node_idx);
+			new_node.m_parentIdx = current_idx;
+			new_node.m_actionTook = neighbor.GetMoveOrder();
+			new_node.m_heuristic = LandmarkHeuristic(new_node_idx, end_idx);
+
+			//every tile of the run costs its turn, the ones a jump crosses are open so they all
+			//cost the open exhaust, and the landing tile adds its own
+			const int run_length = abs(new_node.m_coord.x - current_node.m_coord.x) + abs(new_node.m_coord.y - current_node.m_coord.y);
+			const float open_penalty = GetExhaustPenalty(TILE_TYPE_AIR, for_worker);
+			const float exhaust_penalty = GetExhaustPenalty(s_perceivedTypes[new_node_idx], for_worker);
+			new_node.m_pathCost = current_node.m_pathCost + static_cast<float>(run_length) + 
+				static_cast<float>(run_length - 1) * open_penalty + exhaust_penalty;
+
+			NodeRecord& neighbor_record = GetPathingNode(new_node_idx);
+			switch(neighbor_record.m_nodeState)
+			{
+			case NodeRecord::CLOSED:
+			case NodeRecord::OPEN:
+				{
+					if(neighbor_record.m_pathCost <= new_node.m_pathCost) continue;
+
+					const float better_priority = GetSearchPriority(new_node.m_pathCost, new_node.m_heuristic);
+					if(s_scratch->m_openList.Contains(new_node_idx))
+						s_scratch->m_openList.DecreaseKey(new_node_idx, NodePriority(new_node_idx, better_priority));
+					else
+						s_scratch->m_openList.Push(new_node_idx, NodePriority(new_node_idx, better_priority));
+					break;
+				}
+			case NodeRecord::UNVISITED:
+				{
+					s_scratch->m_openList.Push(new_node_idx, NodePriority(new_node_idx, GetSearchPriority(new_node.m_pathCost, new_node.m_heuristic)));
+					break;
+				}
+			}
+
+			neighbor_record.m_coord = new_node.m_coord;
+			neighbor_record.m_parentIdx = new_node.m_parentIdx;
+			neighbor_record.m_actionTook = new_node.m_actionTook;
+			neighbor_record.m_pathCost = new_node.m_pathCost;
+			neighbor_record.m_nodeState = NodeRecord::OPEN;
+		}
+
+		GetPathingNode(current_idx).m_nodeState = NodeRecord::CLOSED;
+	}
+
+	if(current_node.m_coord != end)
+	{
+		order_list.push_back(ORDER_HOLD);
+	}
+	else
+	{
+		int current_idx = end_idx;
+
+		//every jump is a straight run, so repeat its move once per tile back to the parent
+		while(current_idx != start_idx)
+		{
+			const NodeRecord& path_node = GetPathingNode(current_idx);
+			const IntVec2 parent_coord = GetTileCoord(path_node.m_parentIdx);
+			const int run_length = abs(path_node.m_coord.x - parent_coord.x) + abs(path_node.m_coord.y - parent_coord.y);
+
+			for(int step = 0; step < run_length; ++step)
+			{
+				order_list.push_back(path_node.m_actionTook);
+			}
+
+			current_idx = path_node.m_parentIdx;
+		}
+
+		std::reverse(order_list.begin(),order_list.end());
+	}
+
+	ResetPathingMap();
+	return order_list;
+}
+
+
+//A* from the start and from the end, always growing the smaller frontier. Steps cost one plus
+//the exhaust penalty so the landmark bound is a consistent heuristic for both sides, and every time one
+//side reaches a tile the other side has a cost for, the joined route is a candidate. Once the
+//lowest f on either side is no better than the best candidate nothing left can beat it.
+//Out of budget it still returns the best meeting found so far
+STATIC std::vector<eOrderCode> Geographer::PathfindBidirectional(const IntVec2& start, const IntVec2& end, bool for_worker)
+{
+	std::vector<eOrderCode> order_list;
+	s_scratch->m_lastNumExpansions = 0;
+	if(start == end)
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	const int start_idx = GetTileIndex(start);
+	const int end_idx = GetTileIndex(end);
+	const int max_expansions = s_mapDimensions * 16;
+
+	NodeRecord& start_node = GetPathingNode(start_idx);
+	start_node.m_coord = start;
+	start_node.m_pathCost = 0;
+	start_node.m_nodeState = NodeRecord::OPEN;
+
+	NodeRecord& end_node = GetReversePathingNode(end_idx);
+	end_node.m_coord = end;
+	end_node.m_pathCost = 0;
+	end_node.m_nodeState = NodeRecord::OPEN;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(start_idx, NodePriority(start_idx, LandmarkHeuristic(start_idx, end_idx)));
+	s_scratch->m_reverseOpenList.Clear();
+	s_scratch->m_reverseOpenList.Push(end_idx, NodePriority(end_idx, LandmarkHeuristic(end_idx, start_idx)));
+
+	float best_cost = FLT_MAX;
+	int meet_idx = -1;
+	while(s_scratch->m_openList.GetSize() > 0 && s_scratch->m_reverseOpenList.GetSize() > 0 && s_scratch->m_lastNumExpansions < max_expansions)
+	{
+		const float forward_min = s_scratch->m_openList.GetItem(s_scratch->m_openList.PeekKey()).m_priority;
+		const float reverse_min = s_scratch->m_reverseOpenList.GetItem(s_scratch->m_reverseOpenList.PeekKey()).m_priority;
+		if(std::max(forward_min, reverse_min) >= best_cost) break;
+
+		++s_scratch->m_lastNumExpansions;
+		if(s_scratch->m_openList.GetSize() <= s_scratch->m_reverseOpenList.GetSize())
+			ExpandBidirectional(true, end_idx, for_worker, best_cost, meet_idx);
+		else
+			ExpandBidirectional(false, start_idx, for_worker, best_cost, meet_idx);
+	}
+
+	if(meet_idx == -1)
+	{
+		order_list.push_back(ORDER_HOLD);
+		ResetPathingMap();
+		return order_list;
+	}
+
+	//the start side is read back to front, the end side already runs toward the goal
+	for(int current_idx = meet_idx; current_idx != start_idx; current_idx = GetPathingNode(current_idx).m_parentIdx)
+	{
+		order_list.push_back(GetPathingNode(current_idx).m_actionTook);
+	}
+
+	std::reverse(order_list.begin(), order_list.end());
+
+	for(int current_idx = meet_idx; current_idx != end_idx; current_idx = GetReversePathingNode(current_idx).m_parentIdx)
+	{
+		order_list.push_back(GetNeighborMoveOrder(current_idx, GetReversePathingNode(current_idx).m_parentIdx));
+	}
+
+	ResetPathingMap();
+	return order_list;
+}
+
+
+STATIC int Geographer::GetLastNumExpansions()
+{
+	return s_scratch->m_lastNumExpansions;
+}
+
+
+//--------------------------------------------------------------------------
+// Bidirectional helpers
+
+
+//pops one node off either side. The end side walks moves backward, so it pays for the tile it
+//is leaving instead of the one it steps onto. The other side's root may be a tile this ant could
+//not stand on, like food buried in dirt, it is still let in so the two sides can meet there
+STATIC void Geographer::ExpandBidirectional(const bool forward, const int other_root_index,
+	const bool for_worker, float& in_out_best_cost, int& in_out_meet_index)
+{
+	IndexedMinHeap<NodePriority>& open_list = forward ? s_scratch->m_openList : s_scratch->m_reverseOpenList;
+	const int current_idx = open_list.Pop().m_idx;
+	NodeRecord& current_node = forward ? GetPathingNode(current_idx) : GetReversePathingNode(current_idx);
+	current_node.m_nodeState = NodeRecord::CLOSED;
+
+	for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+	{
+		const int next_idx = neighbor.GetTileIndex();
+		if(next_idx != other_root_index && !IsWalkableTile(next_idx, for_worker)) continue;
+
+		const int charged_idx = forward ? next_idx : current_idx;
+		const float new_cost = current_node.m_pathCost + 1.0f + 
+			GetExhaustPenalty(s_perceivedTypes[charged_idx], for_worker);
+
+		NodeRecord& next_node = forward ? GetPathingNode(next_idx) : GetReversePathingNode(next_idx);
+		if(next_node.m_pathCost <= new_cost) continue;
+
+		next_node.m_coord = neighbor.GetCoord(current_node.m_coord);
+		next_node.m_parentIdx = current_idx;
+		next_node.m_actionTook = neighbor.GetMoveOrder();
+		next_node.m_pathCost = new_cost;
+		next_node.m_nodeState = NodeRecord::OPEN;
+		open_list.Push(next_idx, NodePriority(next_idx, new_cost + LandmarkHeuristic(next_idx, other_root_index)));
+
+		const NodeRecord& other_node = forward ? GetReversePathingNode(next_idx) : GetPathingNode(next_idx);
+		if(other_node.m_pathCost != FLT_MAX && new_cost + other_node.m_pathCost < in_out_best_cost)
+		{
+			in_out_best_cost = new_cost + other_node.m_pathCost;
+			in_out_meet_index = next_idx;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------
+// Jump point helpers
+
+
+//a tile the ant pays no more for than air, the table for each cost model is built from its own costs
+STATIC bool Geographer::IsOpenTile(const int tile_index, const bool for_worker)
+{
+	const float open_penalty = GetExhaustPenalty(TILE_TYPE_AIR, for_worker);
+	return open_penalty < IMPASSABLE_PENALTY && GetExhaustPenalty(s_perceivedTypes[tile_index], for_worker) == open_penalty;
+}
+
+
+STATIC bool Geographer::HasCostlyNeighbor(const int tile_index, const bool for_worker)
+{
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		if(!IsOpenTile(neighbor.GetTileIndex(), for_worker)) return true;
+	}
+
+	return false;
+}
+
+
+//moving vertically from prev into tile, the side is forced when it opens up beside a costly tile
+STATIC bool Geographer::IsForcedSide(const int prev_index, const int tile_index, const eNeighborDir side, const bool for_worker)
+{
+	if((s_neighborMask[tile_index] & (1 << side)) == 0) return false;
+
+	const int offset = s_neighborOffsets[side];
+	return IsOpenTile(tile_index + offset, for_worker) && 
+		!IsOpenTile(prev_index + offset, for_worker);
+}
+
+
+//each run reads the tile one step ahead, so every direction is swept from the far edge back.
+//Vertical runs go first, a horizontal run stops wherever a vertical run would find a jump point
+STATIC void Geographer::RebuildJumpTable()
+{
+	const int width = s_mapDimensions;
+
+	for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
+	{
+		const bool for_worker = model_idx != 0;
+
+		for(int y_idx = width - 1; y_idx >= 0; --y_idx)
+			for(int x_idx = 0; x_idx < width; ++x_idx)
+				SetJumpDistance(y_idx * width + x_idx, NEIGHBOR_NORTH, for_worker);
+
+		for(int y_idx = 0; y_idx < width; ++y_idx)
+			for(int x_idx = 0; x_idx < width; ++x_idx)
+				SetJumpDistance(y_idx * width + x_idx, NEIGHBOR_SOUTH, for_worker);
+
+		for(int y_idx = 0; y_idx < width; ++y_idx)
+		{
+			for(int x_idx = width - 1; x_idx >= 0; --x_idx)
+				SetJumpDistance(y_idx * width + x_idx, NEIGHBOR_EAST, for_worker);
+
+			for(int x_idx = 0; x_idx < width; ++x_idx)
+				SetJumpDistance(y_idx * width + x_idx, NEIGHBOR_WEST, for_worker);
+		}
+	}
+
+	s_jumpTableDirty = false;
+}
+
+
+STATIC void Geographer::SetJumpDistance(const int tile_index, const eNeighborDir dir, const bool for_worker)
+{
+	short (*jump_table)[NUM_CARDINAL_DIRS] = s_jumpDistance[for_worker];
+	short& distance = jump_table[tile_index][dir];
+	const int next_idx = tile_index + s_neighborOffsets[dir];
+
+	if((s_neighborMask[tile_index] & (1 << dir)) == 0 || !IsOpenTile(next_idx, for_worker))
+	{
+		distance = 0;
+		return;
+	}
+
+	bool is_jump_point = HasCostlyNeighbor(next_idx, for_worker);
+	if(dir == NEIGHBOR_NORTH || dir == NEIGHBOR_SOUTH)
+	{
+		is_jump_point = is_jump_point || 
+			IsForcedSide(tile_index, next_idx, NEIGHBOR_EAST, for_worker) || 
+			IsForcedSide(tile_index, next_idx, NEIGHBOR_WEST, for_worker);
+	}
+	else
+	{
+		is_jump_point = is_jump_point || 
+			jump_table[next_idx][NEIGHBOR_NORTH] > 0 || 
+			jump_table[next_idx][NEIGHBOR_SOUTH] > 0;
+	}
+
+	const int next_distance = jump_table[next_idx][dir];
+	if(is_jump_point)			distance = 1;
+	else if(next_distance > 0)	distance = next_distance + 1;
+	else						distance = next_distance - 1;
+}
+
+
+//returns the first jump point from the tile in one direction, or -1 if the run dead ends.
+//The goal is not in the table, so it is checked against the run here, on a horizontal run
+//the goal also counts when a vertical run from the crossing column would reach it
+STATIC int Geographer::Jump(const int from_index, const eNeighborDir dir, const int end_index, const bool for_worker)
+{
+	const int distance = s_jumpDistance[for_worker][from_index][dir];
+	const int run_length = distance > 0 ? distance : -distance;
+	const bool is_horizontal = dir == NEIGHBOR_EAST || dir == NEIGHBOR_WEST;
+	const int dir_sign = (dir == NEIGHBOR_EAST || dir == NEIGHBOR_NORTH) ? 1 : -1;
+
+	const IntVec2 from_coord = GetTileCoord(from_index);
+	const IntVec2 end_coord = GetTileCoord(end_index);
+	const int along = dir_sign * (is_horizontal ? end_coord.x - from_coord.x : end_coord.y - from_coord.y);
+	const int across = is_horizontal ? end_coord.y - from_coord.y : end_coord.x - from_coord.x;
+
+	int steps = distance > 0 ? distance : -1;
+	if(along >= 1 && along <= run_length && (steps < 0 || along < steps))
+	{
+		if(across == 0)
+		{
+			steps = along;
+		}
+		else if(is_horizontal)
+		{
+			const int crossing_idx = from_index + along * s_neighborOffsets[dir];
+			const int vertical = s_jumpDistance[for_worker][crossing_idx][across > 0 ? NEIGHBOR_NORTH : NEIGHBOR_SOUTH];
+			const int vertical_length = vertical > 0 ? vertical : -vertical;
+			if(vertical_length >= abs(across)) steps = along;
+		}
+	}
+
+	if(steps < 0) return -1;
+	return from_index + steps * s_neighborOffsets[dir];
+}
+
+
+//--------------------------------------------------------------------------
+// Perceived map helpers
+
+
+STATIC bool Geographer::DoesTileHaveFood(const int tile_index)
+{
+	return (s_perceivedFood[tile_index / 64] >> (tile_index % 64)) & 1;
+}
+
+
+STATIC void Geographer::SetTileHasFood(const int tile_index, const bool has_food)
+{
+	const unsigned long long tile_bit = 1ull << (tile_index % 64);
+	if(has_food)	s_perceivedFood[tile_index / 64] |= tile_bit;
+	else			s_perceivedFood[tile_index / 64] &= ~tile_bit;
+}
+
+
+//the ant heading for the food on this tile, UINT_MAX when nobody is
+STATIC AgentID Geographer::GetFoodClaim(const int tile_index)
+{
+	const auto claim_iter = s_foodClaims.find(tile_index);
+	return claim_iter == s_foodClaims.end() ? UINT_MAX : claim_iter->second;
+}
+
+
+//--------------------------------------------------------------------------
+// Bitboard helpers
+
+
+//the raw tile byte names the plane, anything that is not a real type counts as unseen
+STATIC int Geographer::GetTilePlaneIndex(const eTileType tile_type)
+{
+	return tile_type < NUM_TILE_TYPES ? static_cast<int>(tile_type) : UNSEEN_TILE_PLANE;
+}
+
+
+STATIC void Geographer::RebuildTilePlanes()
+{
+	for(int plane_idx = 0; plane_idx < NUM_TILE_PLANES; ++plane_idx)
+	{
+		s_tilePlanes[plane_idx].Clear();
+	}
+
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		s_tilePlanes[GetTilePlaneIndex(s_perceivedTypes[tile_idx])].Set(GetTileCoord(tile_idx));
+	}
+}
@@ -1,9 +1,19 @@
 #pragma once
 #include "Blackboard.hpp"
 #include "Math/IntVec2.hpp"
+#include "Architecture/BucketQueue.hpp"
+#include "Geographer/BitBoard.hpp"
+#include "Geographer/TileDiff.hpp"
+#include "Geographer/EnemyIndex.hpp"
+#include <unordered_map>
+#include <mutex>
 
 struct TileRecord;
 struct NodeRecord;
+struct NodePriority;
+struct HierarchyCluster;
+struct PathCacheEntry;
+struct PathingScratch;
 
 enum eMapData
 {
@@ -17,9 +27,63 @@ enum eMapData
 	NUM_MAP_DATA
 };
 
+//cardinal directions come first and line up with ORDER_MOVE_EAST..ORDER_MOVE_SOUTH
+enum eNeighborDir
+{
+	NEIGHBOR_EAST,
+	NEIGHBOR_NORTH,
+	NEIGHBOR_WEST,
+	NEIGHBOR_SOUTH,
+
+	NEIGHBOR_NORTH_EAST,
+	NEIGHBOR_NORTH_WEST,
+	NEIGHBOR_SOUTH_WEST,
+	NEIGHBOR_SOUTH_EAST,
+
+	NUM_NEIGHBOR_DIRS,
+	NUM_CARDINAL_DIRS = NEIGHBOR_NORTH_EAST
+};
+
+//exhaust tables are indexed by the raw tile byte so TILE_TYPE_UNSEEN needs no special case,
+//anything at or above IMPASSABLE_PENALTY is a wall for that agent
+constexpr int NUM_TILE_TYPE_VALUES = 256;
+constexpr float IMPASSABLE_PENALTY = 1000.0f;
+
+//HPA* cuts the map into square clusters, long paths search between cluster entrances first
+constexpr int CLUSTER_SIZE = 16;
+constexpr int MAX_CLUSTERS_PER_ROW = (MAX_ARENA_WIDTH + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+constexpr int MAX_CLUSTERS = MAX_CLUSTERS_PER_ROW * MAX_CLUSTERS_PER_ROW;
+constexpr int LONG_ENTRANCE_LENGTH = 6; //a border run this long gets an entrance at both ends
+constexpr int NUM_HIERARCHY_COST_MODELS = 2; //indexed by for_worker
+constexpr int MAX_PATH_CACHE_ENTRIES = 4096; //the cache starts over once it holds this many routes
+
+//cooperative pathing reserves the tiles each ant will stand on for the next few turns,
+//one bit per tile per turn. Replanning inside the window stays within a small box around the ant
+constexpr int RESERVATION_WINDOW = 8;
+constexpr int RESERVATION_WORDS = (MAX_ARENA_TILES + 31) / 32;
+constexpr int RESERVATION_BOX_WIDTH = 2 * RESERVATION_WINDOW + 1;
+constexpr int RESERVATION_BOX_AREA = RESERVATION_BOX_WIDTH * RESERVATION_BOX_WIDTH;
+
+//one bitplane per tile type, the last plane holds the tiles no ant has seen yet
+constexpr int UNSEEN_TILE_PLANE = NUM_TILE_TYPES;
+constexpr int NUM_TILE_PLANES = NUM_TILE_TYPES + 1;
+
+//ALT heuristic, step counts from a few landmark tiles with stone as the only wall. No agent
+//walks through stone and stone never opens back up, so the tables never overestimate
+constexpr int MAX_LANDMARKS = 8;			//the queen's start, the four corners, then the farthest tiles
+constexpr int NUM_FIXED_LANDMARKS = 5;
+constexpr unsigned short LANDMARK_UNREACHED = 0xFFFF;
+
+//every step costs a whole number, so path cost plus the landmark bound is an exact integer f.
+//Ties on f go to the node nearer the goal, its bound picks one of these slots below the next f
+constexpr int SEARCH_TIE_BREAK_SLOTS = 32;
+
 class Geographer
 {
 	friend class SearchGraph;
+	friend struct NeighborIterator;
+	friend class DStarLite;
+	friend class AnytimeSearch;
 	
 public:
 	~Geographer();
@@ -32,31 +96,56 @@ public:
 	static bool						DoesCoordHaveFood(const IntVec2& coord );
 	static bool						IsSafeTile( const IntVec2& coord );
 	static bool						IsTileSurrounded(const IntVec2& coord);
-	static std::vector<IntVec2>		FourNeighbors( const IntVec2& coord );
-	static std::vector<IntVec2>		EightNeighbors( const IntVec2& coord );
-	static void						UpdateListOfFood(const IntVec2& coord);
+	static eOrderCode				GetOrderTowardQueen(const IntVec2& coord);
+	static eOrderCode				GetStepOrder(const IntVec2& coord, eOrderCode move_order, eAgentType agent_type, eCarryState carry_state);
 	static int						HowMuchFoodCanISee();
 	static int						HowManyEnemiesCanISee();
-	static IntVec2					GetNextEnemyCoord();
+	static IntVec2					GetNearestEnemyCoord(const IntVec2& coord);
+	static const EnemyIndex&		GetEnemyIndex();
+	static AgentFilter				GetThreatFilter();
 	static float					GetHeatMapValueAt(const IntVec2& coord, eMapData map_data);
 	static void						EdgeDetection(std::vector<float>& out_card_dir, const IntVec2& coord, int depth, eMapData heat_map);
+	static void						GetPassablePlane(bool for_worker, BitBoard& out_passable);
+	static void						GetReachableTiles(const IntVec2& start, bool for_worker, BitBoard& out_reached);
+	static int						GetStepDistances(const IntVec2& start, bool for_worker, int max_depth, short* out_steps);
+	static bool						IsReachable(const IntVec2& start, const IntVec2& end, bool for_worker);
 
 	
 	//Alter Records
 	static void		SetMapDimensions( int width );
 	static void		UpdatePerception();
-	static IntVec2	AddAntToFoodTile( AgentID ant );
+	static IntVec2	AddAntToFoodTile( AgentID ant, const IntVec2& ant_coord );
 	static void		RemoveAntFromFoodTile( IntVec2 coord );
+	static int		GetChangedTileCursor();
+	static bool		GetTilesChangedSince( int& in_out_cursor, std::vector<int>& out_tiles );
+	static void		GetTilesChangedThisTurn( std::vector<int>& out_tiles );
+	static void		ClearReservations();
+	static void		ReservePath( const IntVec2& start, const eOrderCode* orders, int num_orders );
 	
 	//helpers
-	static IntVec2	GetTileCoord( short tile_index );
+	static IntVec2	GetTileCoord( int tile_index );
 	static IntVec2	GetCoordFromCardDir( eOrderCode dir, const IntVec2& start_coord, bool reverse_dir = false );
 	static bool		IsValidCoord( const IntVec2& coord );
-	static short	GetTileIndex(const IntVec2& coord);
+	static int		GetTileIndex(const IntVec2& coord);
+	static bool		IsWalkableTile( int tile_index, bool for_worker );
+	static bool		IsWalkableTile( int tile_index, eAgentType agent_type, eCarryState carry_state );
 	static float	ManhattanHeuristic(const IntVec2& start, const IntVec2& end);
+	static float	LandmarkHeuristic(int from_index, int to_index);
+	static float	GetSearchPriority(float path_cost, float heuristic);
 	static float	OctileDistance(const IntVec2& start, const IntVec2& end);
 	static float	EuclideanHeuristic(const IntVec2& start, const IntVec2& end);
+	static void		BuildCostTables();
+	static void		PrepareForPathingBatch( ePathingStrategy strategy );
+	static float	GetExhaustPenalty(eTileType tile_type, bool for_worker);
+	static float	GetExhaustPenalty(eTileType tile_type, eAgentType agent_type, eCarryState carry_state);
+	static float	GetMaxExhaustPenalty(eAgentType agent_type, eCarryState carry_state);
+	static eOrderCode	GetNeighborMoveOrder(int from_index, int to_index);
+	static void		BindPathingScratch( PathingScratch* scratch );
 	static void		ResetPathingMap();
+	static NodeRecord&	GetPathingNode(int tile_index);
+	static NodeRecord&	GetReversePathingNode(int tile_index);
+	static bool		IsPathingNodeStale(int tile_index);
+	static TileRecord	GetTileRecord(int tile_index);
 	static void		GetCenteredSquareDis(std::vector<IntVec2>& out_coords, int depth, bool just_edge);
 	static int		GetCenteredSquareCount(int depth, bool just_edge);
 	
@@ -67,30 +156,226 @@ public:
 	static void DebugPrintCostMap();
 	static void DebugPrintDirectionMap();
 	static void DebugPrintPath(const IntVec2& start, const IntVec2&  end);
+	static void CheckPathCosts();
 
 	//Pathing jobs
 	static eOrderCode GreedyMovement( const IntVec2& start, const IntVec2& end );
 	static std::vector<eOrderCode> PathfindDijkstra( const IntVec2& start, const IntVec2& end );
-	static std::vector<eOrderCode> PathfindAstar( const IntVec2& start, const IntVec2& end, bool for_worker);
+	static std::vector<eOrderCode> PathfindAstar( const IntVec2& start, const IntVec2& end, bool for_worker,
+		eQueueType open_list_type = QUEUE_PRIORITY );
+	static std::vector<eOrderCode> PathfindAstar( const IntVec2& start, const IntVec2& end, eAgentType agent_type,
+		eCarryState carry_state, eQueueType open_list_type = QUEUE_PRIORITY );
+	static std::vector<eOrderCode> PathfindJumpPoint( const IntVec2& start, const IntVec2& end, bool for_worker );
+	static std::vector<eOrderCode> PathfindHierarchical( const IntVec2& start, const IntVec2& end, bool for_worker );
+	static std::vector<eOrderCode> PathfindBidirectional( const IntVec2& start, const IntVec2& end, bool for_worker );
+	static int		GetLastNumExpansions();
+	static std::vector<eOrderCode> Pathfind( const IntVec2& start, const IntVec2& end, bool for_worker,
+		ePathingStrategy strategy = ANT_PATHING_STRATEGY );
+	static std::vector<eOrderCode> PathfindCooperative( const IntVec2& start, const std::vector<eOrderCode>& planned_orders,
+		bool for_worker, eCarryState carry_state = CARRY_NOTHING );
 
 private:
 	Geographer();
 
+	//one kernel per agent type and carry state, the exhaust row is picked at compile time
+	template <typename OpenList>
+	static std::vector<eOrderCode> PathfindAstarForAgent( OpenList& open_list, const IntVec2& start, const IntVec2& end,
+		eAgentType agent_type, eCarryState carry_state );
+	template <eAgentType AGENT_TYPE, typename OpenList>
+	static std::vector<eOrderCode> PathfindAstarForCarry( OpenList& open_list, const IntVec2& start, const IntVec2& end,
+		eCarryState carry_state );
+	template <eAgentType AGENT_TYPE, eCarryState CARRY_STATE, typename OpenList>
+	static std::vector<eOrderCode> PathfindAstar( OpenList& open_list, const IntVec2& start, const IntVec2& end );
+
+	//bidirectional helpers
+	static void		ExpandBidirectional( bool forward, int other_root_index, bool for_worker,
+		float& in_out_best_cost, int& in_out_meet_index );
+
+	//jump point helpers
+	static bool		IsOpenTile( int tile_index, bool for_worker );
+	static bool		HasCostlyNeighbor( int tile_index, bool for_worker );
+	static bool		IsForcedSide( int prev_index, int tile_index, eNeighborDir side, bool for_worker );
+	static void		RebuildJumpTable();
+	static void		SetJumpDistance( int tile_index, eNeighborDir dir, bool for_worker );
+	static int		Jump( int from_index, eNeighborDir dir, int end_index, bool for_worker );
+
+	//hierarchy helpers
+	static int		GetClusterIndex( int tile_index );
+	static void		UpdateHierarchy( bool for_worker );
+	static bool		FindClusterEntrances( int cluster_idx, bool for_worker );
+	static void		AddClusterEntrance( int cluster_idx, int tile_index, bool for_worker );
+	static void		ComputeEntranceCosts( int cluster_idx, bool for_worker );
+	static void		SearchCluster( int root_index, int stop_index, bool for_worker, bool reverse );
+	static bool		SearchAbstractGraph( std::vector<int>& out_waypoints, int start_index, int end_index,
+		const std::vector<float>& start_costs, const std::vector<float>& end_costs, bool for_worker );
+	static void		RelaxAbstractEdge( int from_index, int to_index, float edge_cost, const IntVec2& end );
+	static bool		RefineSegment( std::vector<eOrderCode>& out_orders, int from_index, int to_index, bool for_worker );
+
+	//queen field helpers
+	static void		UpdateQueenField();
+	static void		RebuildQueenField( int queen_index );
+	static void		LowerQueenFieldAround( int tile_index );
+	static void		PropagateQueenField();
+	static float	GetHaulPenalty( int tile_index );
+	static bool		IsHaulableTile( int tile_index );
+
+	//food field helpers
+	static void		UpdateFoodField();
+	static void		SeedFoodSource( int tile_index );
+	static void		ClearFoodSourceRegion( int tile_index, std::vector<int>& out_region );
+	static void		LowerFoodFieldAround( int tile_index );
+	static void		PropagateFoodField();
+
+	//path cache helpers
+	static unsigned long long	GetPathCacheKey( int start_index, int end_index, bool for_worker, ePathingStrategy strategy );
+	static bool		FindCachedPath( std::vector<eOrderCode>& out_orders, unsigned long long cache_key );
+	static void		CachePath( unsigned long long cache_key, const IntVec2& start, const std::vector<eOrderCode>& orders );
+
+	//perception helpers
+	static bool		GatherVisibleTiles( int& out_min_row, int& out_max_row );
+	static void		PerceiveTile( int tile_index );
+	static void		PerceiveAllTiles();
+	static void		FlushSeenMask();
+
+	//component helpers
+	static void		RebuildComponents( bool for_worker );
+	static void		UpdateComponentTile( int tile_index, eTileType old_type, bool for_worker );
+	static bool		CouldSplitAround( int tile_index, bool for_worker );
+	static int		FindComponent( int tile_index, bool for_worker );
+	static void		UniteComponents( int tile_a, int tile_b, bool for_worker );
+	static int		GetComponentRoots( int tile_index, bool for_worker, int* out_roots );
+
+	//landmark helpers
+	static void		ClearLandmarks();
+	static void		RefreshLandmarks();
+	static bool		PlaceLandmark( int slot_index );
+	static int		GetFarthestFromLandmarks();
+	static int		GetNearestNonStoneTile( const IntVec2& coord );
+	static void		BuildLandmarkTable( int slot_index, int root_index );
+
+	//perceived map helpers
+	static bool		DoesTileHaveFood( int tile_index );
+	static void		SetTileHasFood( int tile_index, bool has_food );
+	static AgentID	GetFoodClaim( int tile_index );
+
+	//bitboard helpers
+	static int		GetTilePlaneIndex( eTileType tile_type );
+	static void		RebuildTilePlanes();
+
+	//reservation helpers
+	static bool		IsTileReserved( int tile_index, int time_step );
+	static void		ReserveTile( int tile_index, int time_step );
+	static int		GetReservationState( const IntVec2& box_origin, const IntVec2& coord, int time_step );
+
 private:
 	static Geographer*  s_instance;
 	static int s_mapDimensions;
 	static int s_mapTotalSize;
 
-	static TileRecord s_perceivedMap[MAX_ARENA_TILES];
-	static NodeRecord s_pathingMap[MAX_ARENA_TILES];
-	const static NodeRecord DEFAULT_PATHING_MAP[MAX_ARENA_TILES];
+	//the perceived map, one array per field so a search that only reads tile types only pulls
+	//tile types through the cache. Food is a bit per tile in the TileDiff mask layout, and only
+	//the few food tiles an ant is heading for have an entry in s_foodClaims
+	static eTileType							s_perceivedTypes[MAX_ARENA_TILES];
+	static unsigned long long					s_perceivedFood[TILE_MASK_WORDS];
+	static int									s_lastSeenTurn[MAX_ARENA_TILES];
+	static std::unordered_map<int, AgentID>		s_foodClaims;
+
+	//search scratch, every player thread binds its own so a repath batch can run on all of them.
+	//Only the pointer is thread local, the buffers belong to MainThread
+	static thread_local PathingScratch* s_scratch;
+	
+	//neighbor table, rebuilt whenever the map size changes
+	static int				s_neighborOffsets[NUM_NEIGHBOR_DIRS];
+	static unsigned char	s_neighborMask[MAX_ARENA_TILES];
+
+	//exhaust gained stepping onto each tile byte, built from g_matchInfo once the match starts
+	static float s_exhaustPenalty[NUM_AGENT_TYPES][NUM_CARRY_STATES][NUM_TILE_TYPE_VALUES];
+	static bool s_mustDigToEnter[NUM_AGENT_TYPES][NUM_TILE_TYPE_VALUES];	//the empty handed cost above is a dig and a move
+
+	//JPS+ run lengths per cost model and cardinal direction, > 0 steps to the next jump point,
+	//<= 0 minus the open steps before a dead end. Rebuilt when a tile opens or closes for either model
+	static short	s_jumpDistance[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES][NUM_CARDINAL_DIRS];
+	static bool		s_jumpTableDirty;
+
+	//HPA* abstract graph, one per cost model. s_entranceSlot maps a tile to its place in
+	//its cluster's entrance list, -1 when the tile is not an entrance
+	static int				s_clustersPerRow;
+	static HierarchyCluster	s_clusters[NUM_HIERARCHY_COST_MODELS][MAX_CLUSTERS];
+	static int				s_entranceSlot[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+
+	//finished routes by start, goal, cost model and strategy. Each cluster counts the tile changes
+	//inside it, a route is only handed out again while every cluster it crosses has the count it saw
+	static uint												s_regionVersion[MAX_CLUSTERS];
+	static std::unordered_map<unsigned long long, PathCacheEntry>	s_pathCache;
+	static std::mutex										s_pathCacheLock;
+
+	//connected walkable tiles, one union-find forest per cost model. A tile that opens up joins
+	//its neighbors on the spot, one that closes only forces a relabel when it could have been
+	//the only link between them. Unwalkable tiles have no parent unless they closed in place
+	static int				s_componentParent[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+	static unsigned char	s_componentRank[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+	static bool				s_componentsDirty[NUM_HIERARCHY_COST_MODELS];
+
+	//landmark tables, tile major so one tile's distances to every landmark share a cache line.
+	//Each landmark sits on the tile nearest its anchor that is not stone. New stone only makes
+	//a table loose, so tables are rebuilt one a turn whenever s_wallVersion has moved on
+	static unsigned short	s_landmarkDistance[MAX_ARENA_TILES][MAX_LANDMARKS];
+	static IntVec2			s_landmarkAnchor[MAX_LANDMARKS];
+	static bool				s_isLandmarkBuilt[MAX_LANDMARKS];
+	static uint				s_landmarkWallVersion[MAX_LANDMARKS];
+	static uint				s_wallVersion;
+	static int				s_nextLandmark;
 
-	static std::vector<short> s_foodLoc;
-	static std::vector<short> s_enemyLoc;
+	//worker cost to reach the queen from every tile and the move that starts that route.
+	//Tiles that got cheaper since the last update are queued in s_queenFieldLowered,
+	//anything that got dearer forces a full rebuild
+	static float			s_queenDistance[MAX_ARENA_TILES];
+	static eOrderCode		s_queenFlow[MAX_ARENA_TILES];
+	static int				s_queenFieldRoot;
+	static bool				s_queenFieldDirty;
+	static std::vector<int>	s_queenFieldLowered;
+
+	//multi-source field over every unclaimed food tile, same worker costs as the queen field.
+	//s_foodSource is the food tile each route ends on, so dropping a source only has to redo
+	//the tiles that were heading to it
+	static float			s_foodDistance[MAX_ARENA_TILES];
+	static int				s_foodSource[MAX_ARENA_TILES];
+	static int				s_numFoodSources;
+	static bool				s_foodFieldDirty;
+	static std::vector<int>	s_foodFieldAdded;
+	static std::vector<int>	s_foodFieldRemoved;
+	static std::vector<int>	s_foodFieldLowered;
+
+	//every tile whose type changed, oldest first, for searches that keep state across turns.
+	//Readers hold a cursor into it, s_changedTilesBase is the cursor of the first entry
+	//still kept, so anyone behind that has missed changes and must start over
+	static std::vector<int>	s_changedTiles;
+	static int				s_changedTilesBase;
+	static int				s_perceptionCursor;	//where this turn's changes start
+
+	//our ants' sight this turn, perception only reads these tiles
+	static BitBoard			s_visibleTiles;
+
+	//when most of the map is in sight it is diffed whole instead. Tiles in s_seenMask were seen
+	//on the diff of s_seenMaskTurn, their s_lastSeenTurn is only written once they leave sight
+	static unsigned long long	s_dirtyMask[TILE_MASK_WORDS];
+	static unsigned long long	s_seenMask[TILE_MASK_WORDS];
+	static int					s_seenMaskTurn;
+	static int					s_dirtyTiles[MAX_ARENA_TILES];
+
+	//space-time reservations, rebuilt every turn from the paths the ants commit to.
+	//Time step 0 is where each ant stands now, step t is where it will be after t orders
+	static uint		s_reservations[RESERVATION_WINDOW + 1][RESERVATION_WORDS];
+
+	//kept in step with s_perceivedTypes, a passable plane is an OR of a few of these
+	static BitBoard	s_tilePlanes[NUM_TILE_PLANES];
+
+	//every agent we observed this turn, bucketed by where it stands
+	static EnemyIndex	s_enemyIndex;
 };
 
 //Structure to relative information together for one tile
-//These will be saved in a 1D array where the index -> coord
+//The Geographer keeps each field in its own array, GetTileRecord gathers one tile's back up
 struct TileRecord
 {
 	eTileType	m_tileType = TILE_TYPE_UNSEEN;
@@ -100,26 +385,52 @@ struct TileRecord
 };
 
 //Structure to keep track of nodes
+//m_generation stamps which search last touched the node, a stale stamp reads as UNVISITED
 struct NodeRecord
 {
 	enum eNodeState {UNVISITED, OPEN, CLOSED};
 
 	IntVec2		m_coord = IntVec2(-1, -1);
-	short		m_parentIdx = -1;
+	int			m_parentIdx = -1;
 	eOrderCode	m_actionTook = ORDER_HOLD;
 	float		m_pathCost = FLT_MAX; 
 	float		m_heuristic = 0.0f;
 	eNodeState	m_nodeState = UNVISITED;
+	uint		m_generation = 0;
+};
+
+//One HPA* cluster, the entrance tiles on its borders and the cost between every pair of them
+//through the cluster, m_entranceCosts[from * num_entrances + to], FLT_MAX when cut off
+struct HierarchyCluster
+{
+	std::vector<int>	m_entrances;
+	std::vector<float>	m_entranceCosts;
+	bool				m_isDirty = true;
+};
+
+//A cached route stored as runs of the same order, and the clusters it crosses with the
+//version each one had when the route was found
+struct PathCacheEntry
+{
+	struct OrderRun
+	{
+		eOrderCode		m_order = ORDER_HOLD;
+		unsigned char	m_count = 0;
+	};
+
+	std::vector<OrderRun>	m_runs;
+	std::vector<int>		m_regions;
+	std::vector<uint>		m_regionVersions;
 };
 
 struct NodePriority
 {
 	NodePriority() = default;
-	NodePriority(const short idx, const float priority):
+	NodePriority(const int idx, const float priority):
 		m_idx(idx), m_priority(priority) {}
 	~NodePriority() = default;
 	
-	short m_idx = -1;
+	int m_idx = -1;
 	float m_priority = -1.0f;
 
 	friend bool operator==(const NodePriority& lhs, const NodePriority& rhs)
@@ -142,4 +453,99 @@ struct NodePriority
 		return lhs.m_priority > rhs.m_priority;
 	}
 
-};
\ No newline at end of file
+};
+
+//Everything a search writes while it plans, sized for the largest map. MainThread allocates one
+//per player thread and the thread binds it with Geographer::BindPathingScratch before searching
+struct PathingScratch
+{
+	PathingScratch();
+	~PathingScratch() = default;
+
+	std::vector<NodeRecord>			m_pathingMap;
+	std::vector<NodeRecord>			m_reversePathingMap;	//the goal side of a bidirectional search, same generation
+	uint							m_pathingGeneration = 1;
+	IndexedMinHeap<NodePriority>	m_openList;
+	IndexedMinHeap<NodePriority>	m_reverseOpenList;
+	BucketQueue						m_bucketOpenList;
+	int								m_lastNumExpansions = 0;
+
+	//planes for the whole map floods
+	BitBoard						m_passable;
+	BitBoard						m_reached;
+	BitBoard						m_layers[2];
+};
+
+//Walks the in-bounds neighbors of a tile using the offset table and border masks
+//built in Geographer::SetMapDimensions, so expanding a node never allocates
+//	for(NeighborIterator neighbor(tile_idx); neighbor.IsValid(); neighbor.Next())
+struct NeighborIterator
+{
+public:
+	explicit NeighborIterator(const int tile_index, const bool include_diagonals = false):
+		m_tileIdx(tile_index),
+		m_mask(Geographer::s_neighborMask[tile_index]),
+		m_order(include_diagonals ? OCTILE_ORDER : CARDINAL_ORDER),
+		m_numSteps(include_diagonals ? NUM_NEIGHBOR_DIRS : NUM_CARDINAL_DIRS)
+	{
+		SkipInvalid();
+	}
+
+	bool IsValid() const
+	{
+		return m_step < m_numSteps;
+	}
+
+	void Next()
+	{
+		++m_step;
+		SkipInvalid();
+	}
+
+	eNeighborDir GetDir() const
+	{
+		return static_cast<eNeighborDir>(m_order[m_step]);
+	}
+
+	int GetTileIndex() const
+	{
+		return m_tileIdx + Geographer::s_neighborOffsets[m_order[m_step]];
+	}
+
+	IntVec2 GetCoord(const IntVec2& center) const
+	{
+		return IntVec2(center.x + DIR_X[m_order[m_step]], center.y + DIR_Y[m_order[m_step]]);
+	}
+
+	//diagonals have no move order, they come back as ORDER_HOLD
+	eOrderCode GetMoveOrder() const
+	{
+		if(m_order[m_step] >= NUM_CARDINAL_DIRS) return ORDER_HOLD;
+		return static_cast<eOrderCode>(ORDER_MOVE_EAST + m_order[m_step]);
+	}
+
+private:
+	void SkipInvalid()
+	{
+		while(m_step < m_numSteps && (m_mask & (1 << m_order[m_step])) == 0)
+		{
+			++m_step;
+		}
+	}
+
+private:
+	//eight way walks around the compass so search order matches the old EightNeighbors
+	static constexpr unsigned char CARDINAL_ORDER[NUM_CARDINAL_DIRS] = {
+		NEIGHBOR_EAST, NEIGHBOR_NORTH, NEIGHBOR_WEST, NEIGHBOR_SOUTH };
+	static constexpr unsigned char OCTILE_ORDER[NUM_NEIGHBOR_DIRS] = {
+		NEIGHBOR_EAST, NEIGHBOR_NORTH_EAST, NEIGHBOR_NORTH, NEIGHBOR_NORTH_WEST,
+		NEIGHBOR_WEST, NEIGHBOR_SOUTH_WEST, NEIGHBOR_SOUTH, NEIGHBOR_SOUTH_EAST };
+	static constexpr int DIR_X[NUM_NEIGHBOR_DIRS] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static constexpr int DIR_Y[NUM_NEIGHBOR_DIRS] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+	int						m_tileIdx = -1;
+	unsigned char			m_mask = 0;
+	const unsigned char*	m_order = nullptr;
+	int						m_numSteps = 0;
+	int						m_step = 0;
+};
@@ -0,0 +1,124 @@
+#include "Geographer/Geographer.hpp"
+#include "Architecture/Heap.hpp"
+#include "Architecture/ErrorWarningAssert.hpp"
+#include <vector>
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------
+// Self checks
+
+
+//A* on the heap and on the buckets, and JPS, against a plain Dijkstra over the same one plus
+//exhaust step costs. The map is seeded and its air costs nothing, the case where a bound counted
+//in steps is only admissible if every search charges the step as well. Overwrites the map and the
+//cost tables, so it runs before Startup builds the real ones
+STATIC void Geographer::CheckPathCosts()
+{
+	constexpr int CHECK_MAP_WIDTH = 48;
+	constexpr int NUM_CHECK_ROUTES = 64;
+
+	PathingScratch* scratch = new PathingScratch();
+	BindPathingScratch(scratch);
+
+	//air is free, dirt costs more than a short detour and less than a long one, stone is a wall
+	for(int type_idx = 0; type_idx < NUM_AGENT_TYPES; ++type_idx)
+	{
+		for(int carry_idx = 0; carry_idx < NUM_CARRY_STATES; ++carry_idx)
+		{
+			float* exhaust_table = s_exhaustPenalty[type_idx][carry_idx];
+			for(int tile_value = 0; tile_value < NUM_TILE_TYPE_VALUES; ++tile_value)
+			{
+				exhaust_table[tile_value] = 0.0f;
+			}
+
+			exhaust_table[TILE_TYPE_DIRT] = type_idx == AGENT_TYPE_WORKER ? 3.0f : 6.0f;
+			exhaust_table[TILE_TYPE_STONE] = IMPASSABLE_PENALTY;
+			exhaust_table[TILE_TYPE_WATER] = IMPASSABLE_PENALTY;
+		}
+	}
+
+	unsigned int seed = 12345u;
+	const auto next_random = [&seed](const int range)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<int>((seed >> 16) % static_cast<unsigned int>(range));
+	};
+
+	for(int tile_idx = 0; tile_idx < CHECK_MAP_WIDTH * CHECK_MAP_WIDTH; ++tile_idx)
+	{
+		const int roll = next_random(100);
+		s_perceivedTypes[tile_idx] = roll < 10 ? TILE_TYPE_STONE : (roll < 40 ? TILE_TYPE_DIRT : TILE_TYPE_AIR);
+	}
+
+	SetMapDimensions(CHECK_MAP_WIDTH);
+	for(int slot_idx = 0; slot_idx < MAX_LANDMARKS; ++slot_idx)
+	{
+		RefreshLandmarks();
+	}
+
+	const auto get_route_cost = [](const IntVec2& start, const std::vector<eOrderCode>& orders, const bool for_worker)
+	{
+		IntVec2 coord = start;
+		float route_cost = 0.0f;
+		for(const eOrderCode order : orders)
+		{
+			if(order == ORDER_HOLD) return -1.0f;
+
+			coord = GetCoordFromCardDir(order, coord);
+			route_cost += 1.0f + GetExhaustPenalty(s_perceivedTypes[GetTileIndex(coord)], for_worker);
+		}
+
+		return route_cost;
+	};
+
+	std::vector<float> reference_cost(s_mapTotalSize);
+	IndexedMinHeap<NodePriority> reference_list(s_mapTotalSize, s_mapTotalSize);
+	for(int route_idx = 0; route_idx < NUM_CHECK_ROUTES; ++route_idx)
+	{
+		const int start_idx = next_random(s_mapTotalSize);
+		const int end_idx = next_random(s_mapTotalSize);
+		if(start_idx == end_idx || s_perceivedTypes[start_idx] != TILE_TYPE_AIR || s_perceivedTypes[end_idx] != TILE_TYPE_AIR) continue;
+
+		const IntVec2 start = GetTileCoord(start_idx);
+		const IntVec2 end = GetTileCoord(end_idx);
+		for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
+		{
+			const bool for_worker = model_idx != 0;
+
+			std::fill(reference_cost.begin(), reference_cost.end(), FLT_MAX);
+			reference_cost[start_idx] = 0.0f;
+			reference_list.Clear();
+			reference_list.Push(start_idx, NodePriority(start_idx, 0.0f));
+			while(reference_list.GetSize() > 0)
+			{
+				const int current_idx = reference_list.Pop().m_idx;
+				for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+				{
+					const int next_idx = neighbor.GetTileIndex();
+					if(!IsWalkableTile(next_idx, for_worker)) continue;
+
+					const float new_cost = reference_cost[current_idx] + 1.0f +
+						GetExhaustPenalty(s_perceivedTypes[next_idx], for_worker);
+					if(new_cost >= reference_cost[next_idx]) continue;
+
+					reference_cost[next_idx] = new_cost;
+					reference_list.Push(next_idx, NodePriority(next_idx, new_cost));
+				}
+			}
+
+			if(reference_cost[end_idx] == FLT_MAX) continue;
+
+			//a search that runs out of budget may give up, a route it does return must be the cheapest
+			const float heap_cost = get_route_cost(start, PathfindAstar(start, end, for_worker, QUEUE_PRIORITY), for_worker);
+			const float bucket_cost = get_route_cost(start, PathfindAstar(start, end, for_worker, QUEUE_BUCKET), for_worker);
+			const float jump_cost = get_route_cost(start, PathfindJumpPoint(start, end, for_worker), for_worker);
+			ASSERT_OR_DIE(heap_cost < 0.0f || heap_cost == reference_cost[end_idx], "A* returned a route dearer than Dijkstra");
+			ASSERT_OR_DIE(bucket_cost < 0.0f || bucket_cost == reference_cost[end_idx], "bucket A* returned a route dearer than Dijkstra");
+			ASSERT_OR_DIE(jump_cost < 0.0f || jump_cost == reference_cost[end_idx], "JPS returned a route dearer than Dijkstra");
+		}
+	}
+
+	BindPathingScratch(nullptr);
+	delete scratch;
+}
@@ -0,0 +1,204 @@
+#include "Geographer/Geographer.hpp"
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC int					Geographer::s_componentParent[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+STATIC unsigned char		Geographer::s_componentRank[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+STATIC bool					Geographer::s_componentsDirty[NUM_HIERARCHY_COST_MODELS] = { true, true };
+
+
+//--------------------------------------------------------------------------
+// Components
+
+
+//O(1)-ish answer before any search runs. An end the agent can not stand on, like a wall it
+//wants to dig or the queen's tile, counts as reached from any walkable tile beside it.
+//Reads the forest without compressing it, so it is safe from every player thread
+STATIC bool Geographer::IsReachable(const IntVec2& start, const IntVec2& end, const bool for_worker)
+{
+	if(!IsValidCoord(start) || !IsValidCoord(end)) return false;
+	if(s_componentsDirty[for_worker]) return true;
+
+	int start_roots[NUM_CARDINAL_DIRS];
+	int end_roots[NUM_CARDINAL_DIRS];
+	const int num_start_roots = GetComponentRoots(GetTileIndex(start), for_worker, start_roots);
+	const int num_end_roots = GetComponentRoots(GetTileIndex(end), for_worker, end_roots);
+
+	for(int start_num = 0; start_num < num_start_roots; ++start_num)
+	{
+		for(int end_num = 0; end_num < num_end_roots; ++end_num)
+		{
+			if(start_roots[start_num] == end_roots[end_num]) return true;
+		}
+	}
+
+	return false;
+}
+
+
+//--------------------------------------------------------------------------
+// Component helpers
+
+
+//labels every walkable tile from scratch, each tile joins the walkable tiles west and south of it
+STATIC void Geographer::RebuildComponents(const bool for_worker)
+{
+	int* parents = s_componentParent[for_worker];
+	unsigned char* ranks = s_componentRank[for_worker];
+
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		parents[tile_idx] = IsWalkableTile(tile_idx, for_worker) ? tile_idx : -1;
+		ranks[tile_idx] = 0;
+	}
+
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		if(parents[tile_idx] < 0) continue;
+
+		const int west_idx = tile_idx - 1;
+		const int south_idx = tile_idx - s_mapDimensions;
+		if(tile_idx % s_mapDimensions > 0 && parents[west_idx] >= 0)	UniteComponents(tile_idx, west_idx, for_worker);
+		if(south_idx >= 0 && parents[south_idx] >= 0)					UniteComponents(tile_idx, south_idx, for_worker);
+	}
+
+	//every tile points straight at its root, later finds are one step until tiles open up
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		if(parents[tile_idx] >= 0) parents[tile_idx] = FindComponent(tile_idx, for_worker);
+	}
+
+	s_componentsDirty[for_worker] = false;
+}
+
+
+STATIC void Geographer::UpdateComponentTile(const int tile_index, const eTileType old_type, const bool for_worker)
+{
+	if(s_componentsDirty[for_worker]) return;
+
+	const bool was_walkable = GetExhaustPenalty(old_type, for_worker) < IMPASSABLE_PENALTY;
+	const bool is_walkable = IsWalkableTile(tile_index, for_worker);
+	if(was_walkable == is_walkable) return;
+
+	if(is_walkable)
+	{
+		//a tile that closed in place may still be linking others, it keeps its parent
+		int* parents = s_componentParent[for_worker];
+		if(parents[tile_index] < 0)
+		{
+			parents[tile_index] = tile_index;
+			s_componentRank[for_worker][tile_index] = 0;
+		}
+
+		for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+		{
+			const int neighbor_idx = neighbor.GetTileIndex();
+			if(IsWalkableTile(neighbor_idx, for_worker)) UniteComponents(tile_index, neighbor_idx, for_worker);
+		}
+	}
+	else if(CouldSplitAround(tile_index, for_worker))
+	{
+		s_componentsDirty[for_worker] = true;
+	}
+}
+
+
+//walks the eight tiles around a closed tile, each step along the ring is between side by side
+//tiles. When the walkable sides all sit on one walkable stretch of the ring they still reach
+//each other around it, so closing the tile can not have cut anything apart
+STATIC bool Geographer::CouldSplitAround(const int tile_index, const bool for_worker)
+{
+	static constexpr int RING_SIZE = 8;
+	static constexpr int RING_X[RING_SIZE] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+	static constexpr int RING_Y[RING_SIZE] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+	const IntVec2 center = GetTileCoord(tile_index);
+	bool is_open[RING_SIZE];
+	int first_closed = -1;
+	for(int ring_num = 0; ring_num < RING_SIZE; ++ring_num)
+	{
+		const IntVec2 coord(center.x + RING_X[ring_num], center.y + RING_Y[ring_num]);
+		is_open[ring_num] = IsValidCoord(coord) && IsWalkableTile(GetTileIndex(coord), for_worker);
+		if(!is_open[ring_num] && first_closed < 0) first_closed = ring_num;
+	}
+
+	if(first_closed < 0) return false;
+
+	//the even ring slots are the four sides
+	int num_stretches_with_side = 0;
+	bool stretch_has_side = false;
+	for(int step = 1; step <= RING_SIZE; ++step)
+	{
+		const int ring_num = (first_closed + step) % RING_SIZE;
+		if(is_open[ring_num])
+		{
+			if(ring_num % 2 == 0) stretch_has_side = true;
+			continue;
+		}
+
+		if(stretch_has_side) ++num_stretches_with_side;
+		stretch_has_side = false;
+	}
+
+	return num_stretches_with_side > 1;
+}
+
+
+//no path compression, several threads may be asking at once
+STATIC int Geographer::FindComponent(const int tile_index, const bool for_worker)
+{
+	const int* parents = s_componentParent[for_worker];
+
+	int root_idx = tile_index;
+	while(parents[root_idx] != root_idx)
+	{
+		root_idx = parents[root_idx];
+	}
+
+	return root_idx;
+}
+
+
+//union by rank keeps the trees shallow enough for finds that never compress
+STATIC void Geographer::UniteComponents(const int tile_a, const int tile_b, const bool for_worker)
+{
+	int* parents = s_componentParent[for_worker];
+	unsigned char* ranks = s_componentRank[for_worker];
+
+	const int root_a = FindComponent(tile_a, for_worker);
+	const int root_b = FindComponent(tile_b, for_worker);
+	if(root_a == root_b) return;
+
+	if(ranks[root_a] < ranks[root_b])
+	{
+		parents[root_a] = root_b;
+	}
+	else
+	{
+		parents[root_b] = root_a;
+		if(ranks[root_a] == ranks[root_b]) ++ranks[root_a];
+	}
+}
+
+
+//the tile's own component when it is walkable, otherwise the components of its walkable sides
+STATIC int Geographer::GetComponentRoots(const int tile_index, const bool for_worker, int* out_roots)
+{
+	if(IsWalkableTile(tile_index, for_worker))
+	{
+		out_roots[0] = FindComponent(tile_index, for_worker);
+		return 1;
+	}
+
+	int num_roots = 0;
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int neighbor_idx = neighbor.GetTileIndex();
+		if(IsWalkableTile(neighbor_idx, for_worker)) out_roots[num_roots++] = FindComponent(neighbor_idx, for_worker);
+	}
+
+	return num_roots;
+}
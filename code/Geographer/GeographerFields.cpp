@@ -0,0 +1,328 @@
+#include "Geographer/Geographer.hpp"
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC float				Geographer::s_queenDistance[MAX_ARENA_TILES];
+STATIC eOrderCode			Geographer::s_queenFlow[MAX_ARENA_TILES];
+STATIC int					Geographer::s_queenFieldRoot = -1;
+STATIC bool					Geographer::s_queenFieldDirty = true;
+STATIC std::vector<int>		Geographer::s_queenFieldLowered = std::vector<int>();
+STATIC float				Geographer::s_foodDistance[MAX_ARENA_TILES];
+STATIC int					Geographer::s_foodSource[MAX_ARENA_TILES];
+STATIC int					Geographer::s_numFoodSources = 0;
+STATIC bool					Geographer::s_foodFieldDirty = true;
+STATIC std::vector<int>		Geographer::s_foodFieldAdded = std::vector<int>();
+STATIC std::vector<int>		Geographer::s_foodFieldRemoved = std::vector<int>();
+STATIC std::vector<int>		Geographer::s_foodFieldLowered = std::vector<int>();
+
+
+//--------------------------------------------------------------------------
+// Queen field helpers
+
+
+//brings the field up to date with this turn's map and queen. A queen step of one tile keeps
+//the old field, every route to her old tile plus that last step is still a real route, so
+//adding the step cost everywhere gives upper bounds and lowering from her new tile fixes the rest
+STATIC void Geographer::UpdateQueenField()
+{
+	const int queen_idx = GetTileIndex(g_queenPos);
+
+	if(!s_queenFieldDirty && s_queenFieldRoot >= 0 && queen_idx != s_queenFieldRoot)
+	{
+		const eOrderCode step_order = GetNeighborMoveOrder(s_queenFieldRoot, queen_idx);
+		if(step_order != ORDER_HOLD && IsHaulableTile(queen_idx))
+		{
+			const float step_cost = 1.0f + GetHaulPenalty(queen_idx);
+			for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+			{
+				if(s_queenDistance[tile_idx] != FLT_MAX) s_queenDistance[tile_idx] += step_cost;
+			}
+
+			s_queenFlow[s_queenFieldRoot] = step_order;
+			s_queenDistance[queen_idx] = 0.0f;
+			s_queenFlow[queen_idx] = ORDER_HOLD;
+			s_queenFieldRoot = queen_idx;
+
+			s_scratch->m_openList.Clear();
+			s_scratch->m_openList.Push(queen_idx, NodePriority(queen_idx, 0.0f));
+			PropagateQueenField();
+		}
+		else
+		{
+			s_queenFieldDirty = true;
+		}
+	}
+
+	if(s_queenFieldDirty || s_queenFieldRoot < 0)
+	{
+		RebuildQueenField(queen_idx);
+	}
+	else if(!s_queenFieldLowered.empty())
+	{
+		s_scratch->m_openList.Clear();
+		for(int lowered_idx : s_queenFieldLowered)
+		{
+			LowerQueenFieldAround(lowered_idx);
+		}
+		PropagateQueenField();
+	}
+
+	s_queenFieldLowered.clear();
+}
+
+
+STATIC void Geographer::RebuildQueenField(const int queen_index)
+{
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		s_queenDistance[tile_idx] = FLT_MAX;
+		s_queenFlow[tile_idx] = ORDER_HOLD;
+	}
+
+	s_queenDistance[queen_index] = 0.0f;
+	s_queenFieldRoot = queen_index;
+	s_queenFieldDirty = false;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(queen_index, NodePriority(queen_index, 0.0f));
+	PropagateQueenField();
+}
+
+
+//a tile got cheaper to walk onto: it may now be reached through a neighbor for less,
+//and every neighbor that steps onto it may now be closer to the queen
+STATIC void Geographer::LowerQueenFieldAround(const int tile_index)
+{
+	if(!IsHaulableTile(tile_index)) return;
+
+	const float enter_cost = 1.0f + GetHaulPenalty(tile_index);
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int next_idx = neighbor.GetTileIndex();
+		if(s_queenDistance[next_idx] == FLT_MAX) continue;
+
+		const float through_cost = s_queenDistance[next_idx] + 1.0f + GetHaulPenalty(next_idx);
+		if(through_cost < s_queenDistance[tile_index])
+		{
+			s_queenDistance[tile_index] = through_cost;
+			s_queenFlow[tile_index] = GetNeighborMoveOrder(tile_index, next_idx);
+		}
+	}
+
+	if(s_queenDistance[tile_index] == FLT_MAX) return;
+
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int prev_idx = neighbor.GetTileIndex();
+		if(!IsHaulableTile(prev_idx)) continue;
+
+		const float through_cost = s_queenDistance[tile_index] + enter_cost;
+		if(through_cost < s_queenDistance[prev_idx])
+		{
+			s_queenDistance[prev_idx] = through_cost;
+			s_queenFlow[prev_idx] = GetNeighborMoveOrder(prev_idx, tile_index);
+			s_scratch->m_openList.Push(prev_idx, NodePriority(prev_idx, through_cost));
+		}
+	}
+}
+
+
+//reverse Dijkstra out of whatever is queued in the open list, it only ever lowers distances.
+//Stepping from a tile onto the popped one costs one plus the exhaust of the popped tile
+STATIC void Geographer::PropagateQueenField()
+{
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_idx = s_scratch->m_openList.Pop().m_idx;
+		const float through_cost = s_queenDistance[current_idx] + 1.0f + GetHaulPenalty(current_idx);
+
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int prev_idx = neighbor.GetTileIndex();
+			if(!IsHaulableTile(prev_idx) || through_cost >= s_queenDistance[prev_idx]) continue;
+
+			s_queenDistance[prev_idx] = through_cost;
+			s_queenFlow[prev_idx] = GetNeighborMoveOrder(prev_idx, current_idx);
+			s_scratch->m_openList.Push(prev_idx, NodePriority(prev_idx, through_cost));
+		}
+	}
+}
+
+
+//a worker carrying food, it walks around anything it would have had to dig
+STATIC float Geographer::GetHaulPenalty(const int tile_index)
+{
+	return s_exhaustPenalty[AGENT_TYPE_WORKER][CARRY_FOOD][s_perceivedTypes[tile_index]];
+}
+
+
+STATIC bool Geographer::IsHaulableTile(const int tile_index)
+{
+	return GetHaulPenalty(tile_index) < IMPASSABLE_PENALTY;
+}
+
+
+//--------------------------------------------------------------------------
+// Food field helpers
+
+
+//folds in the food and terrain changes queued since the last call. Dropped sources are all
+//cleared before any are refilled, so no region refills from a neighbor that is also going away
+STATIC void Geographer::UpdateFoodField()
+{
+	if(s_foodFieldDirty)
+	{
+		for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+		{
+			s_foodDistance[tile_idx] = FLT_MAX;
+			s_foodSource[tile_idx] = -1;
+		}
+
+		s_numFoodSources = 0;
+		s_scratch->m_openList.Clear();
+		for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+		{
+			if(DoesTileHaveFood(tile_idx) && GetFoodClaim(tile_idx) == UINT_MAX)
+			{
+				SeedFoodSource(tile_idx);
+			}
+		}
+
+		s_foodFieldDirty = false;
+	}
+	else
+	{
+		s_scratch->m_openList.Clear();
+
+		std::vector<int> cleared_region;
+		for(int food_idx : s_foodFieldRemoved)
+		{
+			ClearFoodSourceRegion(food_idx, cleared_region);
+		}
+
+		//refill the cleared tiles from whatever still borders them
+		for(int region_idx : cleared_region)
+		{
+			if(!IsWalkableTile(region_idx, true)) continue;
+
+			for(NeighborIterator neighbor(region_idx); neighbor.IsValid(); neighbor.Next())
+			{
+				const int next_idx = neighbor.GetTileIndex();
+				if(s_foodSource[next_idx] < 0) continue;
+
+				const float through_cost = s_foodDistance[next_idx] + 1.0f + 
+					GetExhaustPenalty(s_perceivedTypes[next_idx], true);
+				if(through_cost >= s_foodDistance[region_idx]) continue;
+
+				s_foodDistance[region_idx] = through_cost;
+				s_foodSource[region_idx] = s_foodSource[next_idx];
+				s_scratch->m_openList.Push(region_idx, NodePriority(region_idx, through_cost));
+			}
+		}
+
+		for(int food_idx : s_foodFieldAdded)
+		{
+			SeedFoodSource(food_idx);
+		}
+
+		for(int lowered_idx : s_foodFieldLowered)
+		{
+			LowerFoodFieldAround(lowered_idx);
+		}
+	}
+
+	PropagateFoodField();
+
+	s_foodFieldAdded.clear();
+	s_foodFieldRemoved.clear();
+	s_foodFieldLowered.clear();
+}
+
+
+STATIC void Geographer::SeedFoodSource(const int tile_index)
+{
+	if(s_foodSource[tile_index] == tile_index) return;
+
+	++s_numFoodSources;
+	s_foodDistance[tile_index] = 0.0f;
+	s_foodSource[tile_index] = tile_index;
+	s_scratch->m_openList.Push(tile_index, NodePriority(tile_index, 0.0f));
+}
+
+
+//every tile routed to this food is reached from it through tiles routed the same way,
+//so the region is a flood from the food over matching s_foodSource
+STATIC void Geographer::ClearFoodSourceRegion(const int tile_index, std::vector<int>& out_region)
+{
+	if(s_foodSource[tile_index] != tile_index) return;
+
+	--s_numFoodSources;
+	const size_t first_region = out_region.size();
+	out_region.push_back(tile_index);
+	s_foodSource[tile_index] = -1;
+
+	for(size_t region_num = first_region; region_num < out_region.size(); ++region_num)
+	{
+		const int region_idx = out_region[region_num];
+		s_foodDistance[region_idx] = FLT_MAX;
+
+		for(NeighborIterator neighbor(region_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int next_idx = neighbor.GetTileIndex();
+			if(s_foodSource[next_idx] != tile_index) continue;
+
+			s_foodSource[next_idx] = -1;
+			out_region.push_back(next_idx);
+		}
+	}
+}
+
+
+//same as the queen field, a cheaper tile may be reached for less and may shorten its neighbors
+STATIC void Geographer::LowerFoodFieldAround(const int tile_index)
+{
+	if(!IsWalkableTile(tile_index, true)) return;
+
+	for(NeighborIterator neighbor(tile_index); neighbor.IsValid(); neighbor.Next())
+	{
+		const int next_idx = neighbor.GetTileIndex();
+		if(s_foodSource[next_idx] < 0) continue;
+
+		const float through_cost = s_foodDistance[next_idx] + 1.0f + 
+			GetExhaustPenalty(s_perceivedTypes[next_idx], true);
+		if(through_cost < s_foodDistance[tile_index])
+		{
+			s_foodDistance[tile_index] = through_cost;
+			s_foodSource[tile_index] = s_foodSource[next_idx];
+		}
+	}
+
+	if(s_foodSource[tile_index] >= 0)
+	{
+		s_scratch->m_openList.Push(tile_index, NodePriority(tile_index, s_foodDistance[tile_index]));
+	}
+}
+
+
+STATIC void Geographer::PropagateFoodField()
+{
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_idx = s_scratch->m_openList.Pop().m_idx;
+		const float through_cost = s_foodDistance[current_idx] + 1.0f + 
+			GetExhaustPenalty(s_perceivedTypes[current_idx], true);
+
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int prev_idx = neighbor.GetTileIndex();
+			if(!IsWalkableTile(prev_idx, true) || through_cost >= s_foodDistance[prev_idx]) continue;
+
+			s_foodDistance[prev_idx] = through_cost;
+			s_foodSource[prev_idx] = s_foodSource[current_idx];
+			s_scratch->m_openList.Push(prev_idx, NodePriority(prev_idx, through_cost));
+		}
+	}
+}
@@ -0,0 +1,423 @@
+#include "Geographer/Geographer.hpp"
+#include <algorithm>
+#include "Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC int					Geographer::s_clustersPerRow = 0;
+STATIC HierarchyCluster		Geographer::s_clusters[NUM_HIERARCHY_COST_MODELS][MAX_CLUSTERS];
+STATIC int					Geographer::s_entranceSlot[NUM_HIERARCHY_COST_MODELS][MAX_ARENA_TILES];
+STATIC uint					Geographer::s_regionVersion[MAX_CLUSTERS];
+
+
+//--------------------------------------------------------------------------
+// Hierarchy
+
+
+//HPA*: the map is cut into CLUSTER_SIZE squares with entrances where two clusters share an
+//open stretch of border. A long path is an A* over those entrances, using the costs cached
+//per cluster, then each leg is refined by a search that never leaves its cluster. Costs here
+//count one per step plus the exhaust penalty, and tiles at IMPASSABLE_PENALTY are treated as walls.
+//If the abstract graph finds nothing it falls back to the plain budgeted A*.
+STATIC std::vector<eOrderCode> Geographer::PathfindHierarchical(const IntVec2& start, const IntVec2& end, bool for_worker)
+{
+	std::vector<eOrderCode> order_list;
+	if(start == end)
+	{
+		order_list.push_back(ORDER_HOLD);
+		return order_list;
+	}
+
+	UpdateHierarchy(for_worker);
+
+	const int start_idx = GetTileIndex(start);
+	const int end_idx = GetTileIndex(end);
+	const int start_cluster = GetClusterIndex(start_idx);
+	const int end_cluster = GetClusterIndex(end_idx);
+
+	if(start_cluster == end_cluster && RefineSegment(order_list, start_idx, end_idx, for_worker))
+	{
+		return order_list;
+	}
+
+	//the start and the goal are not part of the graph, link them to their cluster's entrances
+	const HierarchyCluster& start_record = s_clusters[for_worker][start_cluster];
+	const HierarchyCluster& end_record = s_clusters[for_worker][end_cluster];
+	std::vector<float> start_costs(start_record.m_entrances.size(), FLT_MAX);
+	std::vector<float> end_costs(end_record.m_entrances.size(), FLT_MAX);
+
+	SearchCluster(start_idx, -1, for_worker, false);
+	for(size_t entrance_num = 0; entrance_num < start_record.m_entrances.size(); ++entrance_num)
+	{
+		start_costs[entrance_num] = GetPathingNode(start_record.m_entrances[entrance_num]).m_pathCost;
+	}
+	ResetPathingMap();
+
+	SearchCluster(end_idx, -1, for_worker, true);
+	for(size_t entrance_num = 0; entrance_num < end_record.m_entrances.size(); ++entrance_num)
+	{
+		end_costs[entrance_num] = GetPathingNode(end_record.m_entrances[entrance_num]).m_pathCost;
+	}
+	ResetPathingMap();
+
+	std::vector<int> waypoints;
+	if(!SearchAbstractGraph(waypoints, start_idx, end_idx, start_costs, end_costs, for_worker))
+	{
+		return PathfindAstar(start, end, for_worker);
+	}
+
+	for(size_t waypoint_num = 1; waypoint_num < waypoints.size(); ++waypoint_num)
+	{
+		if(!RefineSegment(order_list, waypoints[waypoint_num - 1], waypoints[waypoint_num], for_worker))
+		{
+			order_list.clear();
+			order_list.push_back(ORDER_HOLD);
+			break;
+		}
+	}
+
+	return order_list;
+}
+
+
+//--------------------------------------------------------------------------
+// Hierarchy helpers
+
+
+STATIC int Geographer::GetClusterIndex(const int tile_index)
+{
+	const int x_idx = tile_index % s_mapDimensions;
+	const int y_idx = tile_index / s_mapDimensions;
+	return (y_idx / CLUSTER_SIZE) * s_clustersPerRow + (x_idx / CLUSTER_SIZE);
+}
+
+
+
+
+
+
+//a changed tile can move the entrances on any border of its cluster, so the clusters on the
+//other side of those borders look for entrances again, but only search costs if theirs moved.
+//Entrances are all placed before any costs are searched, costs only read the cluster's own list
+STATIC void Geographer::UpdateHierarchy(const bool for_worker)
+{
+	HierarchyCluster* clusters = s_clusters[for_worker];
+	const int num_clusters = s_clustersPerRow * s_clustersPerRow;
+
+	bool needs_entrances[MAX_CLUSTERS] = {};
+	bool needs_costs[MAX_CLUSTERS] = {};
+	bool any_rebuild = false;
+	for(int cluster_idx = 0; cluster_idx < num_clusters; ++cluster_idx)
+	{
+		if(!clusters[cluster_idx].m_isDirty) continue;
+
+		const int cluster_x = cluster_idx % s_clustersPerRow;
+		const int cluster_y = cluster_idx / s_clustersPerRow;
+		needs_costs[cluster_idx] = true;
+		needs_entrances[cluster_idx] = true;
+		if(cluster_x + 1 < s_clustersPerRow)	needs_entrances[cluster_idx + 1] = true;
+		if(cluster_x > 0)						needs_entrances[cluster_idx - 1] = true;
+		if(cluster_y + 1 < s_clustersPerRow)	needs_entrances[cluster_idx + s_clustersPerRow] = true;
+		if(cluster_y > 0)						needs_entrances[cluster_idx - s_clustersPerRow] = true;
+
+		clusters[cluster_idx].m_isDirty = false;
+		any_rebuild = true;
+	}
+
+	if(!any_rebuild) return;
+
+	for(int cluster_idx = 0; cluster_idx < num_clusters; ++cluster_idx)
+	{
+		if(needs_entrances[cluster_idx] && FindClusterEntrances(cluster_idx, for_worker))
+		{
+			needs_costs[cluster_idx] = true;
+		}
+	}
+
+	for(int cluster_idx = 0; cluster_idx < num_clusters; ++cluster_idx)
+	{
+		if(needs_costs[cluster_idx]) ComputeEntranceCosts(cluster_idx, for_worker);
+	}
+}
+
+
+//walks each border the cluster shares with a neighbor, an entrance is a run of tile pairs that
+//are walkable on both sides. The neighbor walks the same border the same way, so the entrance
+//tiles on either side always line up. Returns true when the entrance list changed
+STATIC bool Geographer::FindClusterEntrances(const int cluster_idx, const bool for_worker)
+{
+	HierarchyCluster& cluster = s_clusters[for_worker][cluster_idx];
+	const std::vector<int> old_entrances = cluster.m_entrances;
+	for(int entrance_tile : cluster.m_entrances)
+	{
+		s_entranceSlot[for_worker][entrance_tile] = -1;
+	}
+	cluster.m_entrances.clear();
+
+	const int min_x = (cluster_idx % s_clustersPerRow) * CLUSTER_SIZE;
+	const int min_y = (cluster_idx / s_clustersPerRow) * CLUSTER_SIZE;
+	const int max_x = Min(min_x + CLUSTER_SIZE, s_mapDimensions) - 1;
+	const int max_y = Min(min_y + CLUSTER_SIZE, s_mapDimensions) - 1;
+
+	for(int dir_idx = 0; dir_idx < NUM_CARDINAL_DIRS; ++dir_idx)
+	{
+		const eNeighborDir dir = static_cast<eNeighborDir>(dir_idx);
+		const bool is_vertical_border = dir == NEIGHBOR_EAST || dir == NEIGHBOR_WEST;
+
+		IntVec2 border_start;
+		border_start.x = dir == NEIGHBOR_EAST ? max_x : min_x;
+		border_start.y = dir == NEIGHBOR_NORTH ? max_y : min_y;
+		const int border_length = is_vertical_border ? max_y - min_y + 1 : max_x - min_x + 1;
+		const int step_offset = is_vertical_border ? s_neighborOffsets[NEIGHBOR_NORTH] : s_neighborOffsets[NEIGHBOR_EAST];
+		const int border_idx = GetTileIndex(border_start);
+
+		//no neighbor on the edge of the map
+		if((s_neighborMask[border_idx] & (1 << dir)) == 0) continue;
+
+		int run_start = -1;
+		for(int position = 0; position <= border_length; ++position)
+		{
+			bool is_open = false;
+			if(position < border_length)
+			{
+				const int inside_idx = border_idx + position * step_offset;
+				is_open = IsWalkableTile(inside_idx, for_worker) && 
+					IsWalkableTile(inside_idx + s_neighborOffsets[dir], for_worker);
+			}
+
+			if(is_open && run_start < 0)
+			{
+				run_start = position;
+			}
+			else if(!is_open && run_start >= 0)
+			{
+				const int run_end = position - 1;
+				if(run_end - run_start + 1 >= LONG_ENTRANCE_LENGTH)
+				{
+					AddClusterEntrance(cluster_idx, border_idx + run_start * step_offset, for_worker);
+					AddClusterEntrance(cluster_idx, border_idx + run_end * step_offset, for_worker);
+				}
+				else
+				{
+					AddClusterEntrance(cluster_idx, border_idx + ((run_start + run_end) / 2) * step_offset, for_worker);
+				}
+
+				run_start = -1;
+			}
+		}
+	}
+
+	return cluster.m_entrances != old_entrances;
+}
+
+
+//a corner tile can sit on two borders, it is only added once
+STATIC void Geographer::AddClusterEntrance(const int cluster_idx, const int tile_index, const bool for_worker)
+{
+	if(s_entranceSlot[for_worker][tile_index] >= 0) return;
+
+	HierarchyCluster& cluster = s_clusters[for_worker][cluster_idx];
+	s_entranceSlot[for_worker][tile_index] = static_cast<int>(cluster.m_entrances.size());
+	cluster.m_entrances.push_back(tile_index);
+}
+
+
+STATIC void Geographer::ComputeEntranceCosts(const int cluster_idx, const bool for_worker)
+{
+	HierarchyCluster& cluster = s_clusters[for_worker][cluster_idx];
+	const size_t num_entrances = cluster.m_entrances.size();
+	cluster.m_entranceCosts.assign(num_entrances * num_entrances, FLT_MAX);
+
+	for(size_t from_num = 0; from_num < num_entrances; ++from_num)
+	{
+		SearchCluster(cluster.m_entrances[from_num], -1, for_worker, false);
+		for(size_t to_num = 0; to_num < num_entrances; ++to_num)
+		{
+			cluster.m_entranceCosts[from_num * num_entrances + to_num] = GetPathingNode(cluster.m_entrances[to_num]).m_pathCost;
+		}
+
+		ResetPathingMap();
+	}
+}
+
+
+//Dijkstra over the pathing map that never leaves the root's cluster, stopping once stop_index
+//is closed (-1 searches the whole cluster). A reverse search charges the tile being left
+//instead of the one entered, so the costs read as the cost to reach the root.
+//The caller reads the results and then resets the pathing map
+STATIC void Geographer::SearchCluster(const int root_index, const int stop_index, const bool for_worker, const bool reverse)
+{
+	const int cluster_idx = GetClusterIndex(root_index);
+
+	NodeRecord& root_node = GetPathingNode(root_index);
+	root_node.m_coord = GetTileCoord(root_index);
+	root_node.m_parentIdx = -1;
+	root_node.m_actionTook = ORDER_HOLD;
+	root_node.m_pathCost = 0;
+	root_node.m_nodeState = NodeRecord::OPEN;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(root_index, NodePriority(root_index, 0.0f));
+
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_idx = s_scratch->m_openList.Pop().m_idx;
+		NodeRecord& current_node = GetPathingNode(current_idx);
+		current_node.m_nodeState = NodeRecord::CLOSED;
+		if(current_idx == stop_index) break;
+
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int new_node_idx = neighbor.GetTileIndex();
+			if(GetClusterIndex(new_node_idx) != cluster_idx || !IsWalkableTile(new_node_idx, for_worker)) continue;
+
+			const int charged_idx = reverse ? current_idx : new_node_idx;
+			const float new_cost = current_node.m_pathCost + 1.0f + 
+				GetExhaustPenalty(s_perceivedTypes[charged_idx], for_worker);
+
+			NodeRecord& new_node = GetPathingNode(new_node_idx);
+			if(new_node.m_nodeState == NodeRecord::CLOSED || new_node.m_pathCost <= new_cost) continue;
+
+			new_node.m_coord = neighbor.GetCoord(current_node.m_coord);
+			new_node.m_parentIdx = current_idx;
+			new_node.m_actionTook = neighbor.GetMoveOrder();
+			new_node.m_pathCost = new_cost;
+			new_node.m_nodeState = NodeRecord::OPEN;
+			s_scratch->m_openList.Push(new_node_idx, NodePriority(new_node_idx, new_cost));
+		}
+	}
+}
+
+
+//A* over the entrance tiles, the start links to its cluster's entrances through start_costs
+//and the goal cluster's entrances link to the goal through end_costs. Every edge costs at
+//least its step count, so the landmark bound never needs a closed node reopened
+STATIC bool Geographer::SearchAbstractGraph(std::vector<int>& out_waypoints, const int start_index, const int end_index,
+	const std::vector<float>& start_costs, const std::vector<float>& end_costs, const bool for_worker)
+{
+	const IntVec2 end = GetTileCoord(end_index);
+	const int end_cluster = GetClusterIndex(end_index);
+
+	NodeRecord& root_node = GetPathingNode(start_index);
+	root_node.m_coord = GetTileCoord(start_index);
+	root_node.m_parentIdx = -1;
+	root_node.m_pathCost = 0;
+	root_node.m_nodeState = NodeRecord::OPEN;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(start_index, NodePriority(start_index, LandmarkHeuristic(start_index, end_index)));
+
+	bool found_goal = false;
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_idx = s_scratch->m_openList.Pop().m_idx;
+		GetPathingNode(current_idx).m_nodeState = NodeRecord::CLOSED;
+		if(current_idx == end_index)
+		{
+			found_goal = true;
+			break;
+		}
+
+		const int cluster_idx = GetClusterIndex(current_idx);
+		const HierarchyCluster& cluster = s_clusters[for_worker][cluster_idx];
+		const int num_entrances = static_cast<int>(cluster.m_entrances.size());
+
+		if(current_idx == start_index)
+		{
+			for(int to_num = 0; to_num < num_entrances; ++to_num)
+			{
+				RelaxAbstractEdge(current_idx, cluster.m_entrances[to_num], start_costs[to_num], end);
+			}
+		}
+
+		//the start can be an entrance itself, so this is not an else
+		const int slot = s_entranceSlot[for_worker][current_idx];
+		if(slot < 0) continue;
+
+		for(int to_num = 0; to_num < num_entrances; ++to_num)
+		{
+			if(to_num == slot) continue;
+			RelaxAbstractEdge(current_idx, cluster.m_entrances[to_num], cluster.m_entranceCosts[slot * num_entrances + to_num], end);
+		}
+
+		if(cluster_idx == end_cluster)
+		{
+			RelaxAbstractEdge(current_idx, end_index, end_costs[slot], end);
+		}
+
+		//step across the border into the entrance on the other side
+		for(NeighborIterator neighbor(current_idx); neighbor.IsValid(); neighbor.Next())
+		{
+			const int across_idx = neighbor.GetTileIndex();
+			if(GetClusterIndex(across_idx) == cluster_idx || s_entranceSlot[for_worker][across_idx] < 0) continue;
+
+			const float step_cost = 1.0f + GetExhaustPenalty(s_perceivedTypes[across_idx], for_worker);
+			RelaxAbstractEdge(current_idx, across_idx, step_cost, end);
+		}
+	}
+
+	if(found_goal)
+	{
+		for(int waypoint_idx = end_index; waypoint_idx != -1; waypoint_idx = GetPathingNode(waypoint_idx).m_parentIdx)
+		{
+			out_waypoints.push_back(waypoint_idx);
+		}
+
+		std::reverse(out_waypoints.begin(), out_waypoints.end());
+	}
+
+	ResetPathingMap();
+	return found_goal;
+}
+
+
+STATIC void Geographer::RelaxAbstractEdge(const int from_index, const int to_index, const float edge_cost, const IntVec2& end)
+{
+	if(edge_cost == FLT_MAX) return;
+
+	const float new_cost = GetPathingNode(from_index).m_pathCost + edge_cost;
+	NodeRecord& to_node = GetPathingNode(to_index);
+	if(to_node.m_nodeState == NodeRecord::CLOSED || to_node.m_pathCost <= new_cost) return;
+
+	to_node.m_coord = GetTileCoord(to_index);
+	to_node.m_parentIdx = from_index;
+	to_node.m_pathCost = new_cost;
+	to_node.m_nodeState = NodeRecord::OPEN;
+	s_scratch->m_openList.Push(to_index, NodePriority(to_index, new_cost + LandmarkHeuristic(to_index, GetTileIndex(end))));
+}
+
+
+//appends the moves from one waypoint to the next, waypoints in different clusters are always
+//the two sides of a border so that leg is a single step
+STATIC bool Geographer::RefineSegment(std::vector<eOrderCode>& out_orders, const int from_index, const int to_index, 
+	const bool for_worker)
+{
+	if(GetClusterIndex(from_index) != GetClusterIndex(to_index))
+	{
+		const eOrderCode step_order = GetNeighborMoveOrder(from_index, to_index);
+		if(step_order == ORDER_HOLD) return false;
+
+		out_orders.push_back(step_order);
+		return true;
+	}
+
+	SearchCluster(from_index, to_index, for_worker, false);
+
+	const bool found_goal = GetPathingNode(to_index).m_nodeState == NodeRecord::CLOSED;
+	if(found_goal)
+	{
+		const size_t first_order = out_orders.size();
+		for(int current_idx = to_index; current_idx != from_index; current_idx = GetPathingNode(current_idx).m_parentIdx)
+		{
+			out_orders.push_back(GetPathingNode(current_idx).m_actionTook);
+		}
+
+		std::reverse(out_orders.begin() + first_order, out_orders.end());
+	}
+
+	ResetPathingMap();
+	return found_goal;
+}
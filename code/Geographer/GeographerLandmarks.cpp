@@ -0,0 +1,173 @@
+#include "Geographer/Geographer.hpp"
+#include <cstring>
+#include "Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC unsigned short		Geographer::s_landmarkDistance[MAX_ARENA_TILES][MAX_LANDMARKS];
+STATIC IntVec2				Geographer::s_landmarkAnchor[MAX_LANDMARKS];
+STATIC bool					Geographer::s_isLandmarkBuilt[MAX_LANDMARKS];
+STATIC uint					Geographer::s_landmarkWallVersion[MAX_LANDMARKS];
+STATIC uint					Geographer::s_wallVersion = 0;
+STATIC int					Geographer::s_nextLandmark = 0;
+
+
+//--------------------------------------------------------------------------
+// Landmarks
+
+
+//ALT, no route between two tiles is shorter than the difference in their distances to a
+//landmark. Never below manhattan, so it drops in wherever ManhattanHeuristic was used
+STATIC float Geographer::LandmarkHeuristic(const int from_index, const int to_index)
+{
+	const unsigned short* from_distances = s_landmarkDistance[from_index];
+	const unsigned short* to_distances = s_landmarkDistance[to_index];
+
+	int best_bound = Abs(from_index % s_mapDimensions - to_index % s_mapDimensions) +
+		Abs(from_index / s_mapDimensions - to_index / s_mapDimensions);
+	for(int slot_idx = 0; slot_idx < MAX_LANDMARKS; ++slot_idx)
+	{
+		if(from_distances[slot_idx] == LANDMARK_UNREACHED || to_distances[slot_idx] == LANDMARK_UNREACHED) continue;
+		best_bound = Max(best_bound, Abs(from_distances[slot_idx] - to_distances[slot_idx]));
+	}
+
+	return static_cast<float>(best_bound);
+}
+
+
+//f with the tie break folded in below one whole step, so the order by f is never changed
+STATIC float Geographer::GetSearchPriority(const float path_cost, const float heuristic)
+{
+	const float tie_break = Min(heuristic, static_cast<float>(SEARCH_TIE_BREAK_SLOTS - 1));
+	return path_cost + heuristic + tie_break / static_cast<float>(SEARCH_TIE_BREAK_SLOTS);
+}
+
+
+//--------------------------------------------------------------------------
+// Landmark helpers
+
+
+//unbuilt tables read as unreached everywhere, so the heuristic skips them without a check
+STATIC void Geographer::ClearLandmarks()
+{
+	memset(s_landmarkDistance, 0xFF, sizeof(s_landmarkDistance));
+
+	for(int slot_idx = 0; slot_idx < MAX_LANDMARKS; ++slot_idx)
+	{
+		s_isLandmarkBuilt[slot_idx] = false;
+	}
+}
+
+
+//one table a turn, taken round robin from the landmarks that are missing or older than the walls
+STATIC void Geographer::RefreshLandmarks()
+{
+	for(int slot_num = 0; slot_num < MAX_LANDMARKS; ++slot_num)
+	{
+		const int slot_idx = (s_nextLandmark + slot_num) % MAX_LANDMARKS;
+		if(s_isLandmarkBuilt[slot_idx] && s_landmarkWallVersion[slot_idx] == s_wallVersion) continue;
+		if(!PlaceLandmark(slot_idx)) continue;
+
+		const int root_idx = GetNearestNonStoneTile(s_landmarkAnchor[slot_idx]);
+		if(root_idx < 0) return;
+
+		BuildLandmarkTable(slot_idx, root_idx);
+		s_nextLandmark = (slot_idx + 1) % MAX_LANDMARKS;
+		return;
+	}
+}
+
+
+//false while the landmark has nowhere to go yet
+STATIC bool Geographer::PlaceLandmark(const int slot_index)
+{
+	if(IsValidCoord(s_landmarkAnchor[slot_index])) return true;
+
+	if(slot_index == 0)
+	{
+		s_landmarkAnchor[slot_index] = g_queenPos;
+	}
+	else
+	{
+		const int farthest_idx = GetFarthestFromLandmarks();
+		if(farthest_idx >= 0) s_landmarkAnchor[slot_index] = GetTileCoord(farthest_idx);
+	}
+
+	return IsValidCoord(s_landmarkAnchor[slot_index]);
+}
+
+
+//the tile whose closest built landmark is furthest away, -1 before any table is built.
+//Landmarks spread this way bound routes heading every direction
+STATIC int Geographer::GetFarthestFromLandmarks()
+{
+	int farthest_idx = -1;
+	int farthest_distance = 0;
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		const unsigned short* distances = s_landmarkDistance[tile_idx];
+
+		int closest_distance = LANDMARK_UNREACHED;
+		for(int slot_idx = 0; slot_idx < MAX_LANDMARKS; ++slot_idx)
+		{
+			closest_distance = Min(closest_distance, static_cast<int>(distances[slot_idx]));
+		}
+
+		if(closest_distance != LANDMARK_UNREACHED && closest_distance > farthest_distance)
+		{
+			farthest_idx = tile_idx;
+			farthest_distance = closest_distance;
+		}
+	}
+
+	return farthest_idx;
+}
+
+
+STATIC int Geographer::GetNearestNonStoneTile(const IntVec2& coord)
+{
+	const BitBoard& stone_plane = s_tilePlanes[TILE_TYPE_STONE];
+	if(!stone_plane.Test(coord)) return GetTileIndex(coord);
+
+	int nearest_idx = -1;
+	float nearest_distance = FLT_MAX;
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		const IntVec2 tile_coord = GetTileCoord(tile_idx);
+		if(stone_plane.Test(tile_coord)) continue;
+
+		const float distance = ManhattanHeuristic(coord, tile_coord);
+		if(distance < nearest_distance)
+		{
+			nearest_idx = tile_idx;
+			nearest_distance = distance;
+		}
+	}
+
+	return nearest_idx;
+}
+
+
+//breadth first over everything that is not stone, a layer of the wavefront per step
+STATIC void Geographer::BuildLandmarkTable(const int slot_index, const int root_index)
+{
+	for(int tile_idx = 0; tile_idx < s_mapTotalSize; ++tile_idx)
+	{
+		s_landmarkDistance[tile_idx][slot_index] = LANDMARK_UNREACHED;
+	}
+
+	BitBoard& passable = s_scratch->m_passable;
+	passable.Fill(s_mapDimensions);
+	passable.AndNot(s_tilePlanes[TILE_TYPE_STONE]);
+	BitBoard::ForEachLayer(GetTileCoord(root_index), passable, LANDMARK_UNREACHED - 1, s_scratch->m_reached,
+		s_scratch->m_layers, [slot_index](const int x_idx, const int y_idx, const int depth)
+	{
+		s_landmarkDistance[y_idx * s_mapDimensions + x_idx][slot_index] = static_cast<unsigned short>(depth);
+	});
+
+	s_isLandmarkBuilt[slot_index] = true;
+	s_landmarkWallVersion[slot_index] = s_wallVersion;
+}
@@ -0,0 +1,98 @@
+#include "Geographer/Geographer.hpp"
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC std::unordered_map<unsigned long long, PathCacheEntry>	Geographer::s_pathCache;
+STATIC std::mutex			Geographer::s_pathCacheLock;
+
+
+//--------------------------------------------------------------------------
+// Path cache helpers
+
+
+//17 bits covers any tile index on the biggest map
+STATIC unsigned long long Geographer::GetPathCacheKey(const int start_index, const int end_index, const bool for_worker,
+	const ePathingStrategy strategy)
+{
+	unsigned long long cache_key = static_cast<unsigned long long>(start_index);
+	cache_key = (cache_key << 17) | static_cast<unsigned long long>(end_index);
+	cache_key = (cache_key << 8) | static_cast<unsigned long long>(strategy & 0x7f);
+	cache_key = (cache_key << 1) | (for_worker ? 1ull : 0ull);
+	return cache_key;
+}
+
+
+//a route through a cluster that changed since it was cached is dropped on the spot
+STATIC bool Geographer::FindCachedPath(std::vector<eOrderCode>& out_orders, const unsigned long long cache_key)
+{
+	std::lock_guard<std::mutex> cache_lock(s_pathCacheLock);
+	const auto cache_iter = s_pathCache.find(cache_key);
+	if(cache_iter == s_pathCache.end()) return false;
+
+	const PathCacheEntry& entry = cache_iter->second;
+	for(int region_num = 0; region_num < static_cast<int>(entry.m_regions.size()); ++region_num)
+	{
+		if(s_regionVersion[entry.m_regions[region_num]] != entry.m_regionVersions[region_num])
+		{
+			s_pathCache.erase(cache_iter);
+			return false;
+		}
+	}
+
+	for(const PathCacheEntry::OrderRun& run : entry.m_runs)
+	{
+		out_orders.insert(out_orders.end(), run.m_count, run.m_order);
+	}
+
+	return true;
+}
+
+
+//only finished routes are kept, a failed or cut off search is worth trying again next time
+STATIC void Geographer::CachePath(const unsigned long long cache_key, const IntVec2& start, 
+	const std::vector<eOrderCode>& orders)
+{
+	if(orders.empty() || orders.front() == ORDER_HOLD) return;
+
+	PathCacheEntry entry;
+	IntVec2 coord = start;
+	int last_region = GetClusterIndex(GetTileIndex(start));
+	entry.m_regions.push_back(last_region);
+
+	for(const eOrderCode order : orders)
+	{
+		if(!entry.m_runs.empty() && entry.m_runs.back().m_order == order && entry.m_runs.back().m_count < UCHAR_MAX)
+			++entry.m_runs.back().m_count;
+		else
+			entry.m_runs.push_back({order, 1});
+
+		coord = GetCoordFromCardDir(order, coord);
+		if(!IsValidCoord(coord)) return;
+
+		//a path is a connected walk, so a cluster only repeats after leaving and coming back
+		const int region = GetClusterIndex(GetTileIndex(coord));
+		if(region != last_region && std::find(entry.m_regions.begin(), entry.m_regions.end(), region) == entry.m_regions.end())
+		{
+			entry.m_regions.push_back(region);
+		}
+
+		last_region = region;
+	}
+
+	for(const int region : entry.m_regions)
+	{
+		entry.m_regionVersions.push_back(s_regionVersion[region]);
+	}
+
+	std::lock_guard<std::mutex> cache_lock(s_pathCacheLock);
+	if(static_cast<int>(s_pathCache.size()) >= MAX_PATH_CACHE_ENTRIES)
+	{
+		s_pathCache.clear();
+	}
+
+	s_pathCache[cache_key] = std::move(entry);
+}
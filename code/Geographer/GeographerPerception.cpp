@@ -0,0 +1,237 @@
+#include "Geographer/Geographer.hpp"
+#include <cstring>
+#include "Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC std::vector<int>		Geographer::s_changedTiles = std::vector<int>();
+STATIC int					Geographer::s_changedTilesBase = 0;
+STATIC int					Geographer::s_perceptionCursor = 0;
+STATIC BitBoard				Geographer::s_visibleTiles;
+STATIC unsigned long long	Geographer::s_dirtyMask[TILE_MASK_WORDS];
+STATIC unsigned long long	Geographer::s_seenMask[TILE_MASK_WORDS];
+STATIC int					Geographer::s_seenMaskTurn = -1;
+STATIC int					Geographer::s_dirtyTiles[MAX_ARENA_TILES];
+
+
+//--------------------------------------------------------------------------
+// Perception
+
+
+STATIC void Geographer::UpdatePerception()
+{
+	//long lived readers catch up every few turns, a log that grows past a map's worth is dropped
+	if(static_cast<int>(s_changedTiles.size()) > MAX_ARENA_TILES)
+	{
+		s_changedTilesBase += static_cast<int>(s_changedTiles.size());
+		s_changedTiles.clear();
+	}
+
+	s_perceptionCursor = GetChangedTileCursor();
+
+	//past half the map walking the sight diamonds costs more than diffing everything
+	int min_row = 0;
+	int max_row = s_mapDimensions - 1;
+	if(GatherVisibleTiles(min_row, max_row) && s_visibleTiles.Count() * 2 < s_mapTotalSize)
+	{
+		FlushSeenMask();
+		s_visibleTiles.ForEachSet(min_row, max_row, [](const int x_idx, const int y_idx)
+		{
+			PerceiveTile(y_idx * s_mapDimensions + x_idx);
+		});
+	}
+	else
+	{
+		PerceiveAllTiles();
+	}
+
+	UpdateFoodField();
+
+	//relabeled here so the searches on the other player threads only ever read the forest
+	for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
+	{
+		if(s_componentsDirty[model_idx]) RebuildComponents(model_idx == 1);
+	}
+
+	RefreshLandmarks();
+
+	s_enemyIndex.Rebuild(g_turnState.observedAgents, g_turnState.numObservedAgents, s_mapDimensions);
+}
+
+
+STATIC int Geographer::GetChangedTileCursor()
+{
+	return s_changedTilesBase + static_cast<int>(s_changedTiles.size());
+}
+
+
+//appends the tiles that changed since the cursor and moves it to the end of the log.
+//false when the cursor is older than the log, the caller has to treat the whole map as changed
+STATIC bool Geographer::GetTilesChangedSince(int& in_out_cursor, std::vector<int>& out_tiles)
+{
+	if(in_out_cursor < s_changedTilesBase) return false;
+
+	const int log_end = GetChangedTileCursor();
+	for(int log_idx = in_out_cursor - s_changedTilesBase; log_idx < static_cast<int>(s_changedTiles.size()); ++log_idx)
+	{
+		out_tiles.push_back(s_changedTiles[log_idx]);
+	}
+
+	in_out_cursor = log_end;
+	return true;
+}
+
+
+//just what this turn's perception pass changed, in the order it found them
+STATIC void Geographer::GetTilesChangedThisTurn(std::vector<int>& out_tiles)
+{
+	int cursor = s_perceptionCursor;
+	GetTilesChangedSince(cursor, out_tiles);
+}
+
+
+//--------------------------------------------------------------------------
+// Perception helpers
+
+
+//the tiles our own ants can see this turn, a diamond of visibilityRange around each of them,
+//laid down a row span at a time. Only these can have changed since we last looked. False when
+//eyes we get no reports for count too, or there is no fog, then every tile is read
+STATIC bool Geographer::GatherVisibleTiles(int& out_min_row, int& out_max_row)
+{
+	if(!g_matchInfo.fogOfWar) return false;
+	if(g_matchInfo.teamSharedVision && g_matchInfo.numTeams < g_matchInfo.numPlayers) return false;
+
+	s_visibleTiles.Clear();
+	out_min_row = s_mapDimensions;
+	out_max_row = -1;
+
+	for(int report_num = 0; report_num < g_turnState.numReports; ++report_num)
+	{
+		const AgentReport& report = g_turnState.agentReports[report_num];
+		if(report.type >= NUM_AGENT_TYPES) continue;
+
+		const int range = g_matchInfo.agentTypeInfos[report.type].visibilityRange;
+		const int first_row = Max(report.tileY - range, 0);
+		const int last_row = Min(report.tileY + range, s_mapDimensions - 1);
+		for(int row = first_row; row <= last_row; ++row)
+		{
+			const int half_width = range - Abs(row - report.tileY);
+			s_visibleTiles.SetSpan(row, Max(report.tileX - half_width, 0), Min(report.tileX + half_width, s_mapDimensions - 1));
+		}
+
+		out_min_row = Min(out_min_row, first_row);
+		out_max_row = Max(out_max_row, last_row);
+	}
+
+	return true;
+}
+
+
+//brings one tile of the perceived map up to date with what the server shows us. A tile the
+//server still reports unseen keeps whatever we remember of it
+STATIC void Geographer::PerceiveTile(const int tile_index)
+{
+	if(g_turnState.observedTiles[tile_index] == TILE_TYPE_UNSEEN) return;
+
+	if(s_perceivedTypes[tile_index] != g_turnState.observedTiles[tile_index])
+	{
+		const bool was_worker_open = IsOpenTile(tile_index, true);
+		const bool was_soldier_open = IsOpenTile(tile_index, false);
+		const eTileType old_type = s_perceivedTypes[tile_index];
+		const float old_worker_penalty = GetExhaustPenalty(old_type, true);
+		const float old_haul_penalty = GetHaulPenalty(tile_index);
+		const IntVec2 tile_coord = GetTileCoord(tile_index);
+		s_tilePlanes[GetTilePlaneIndex(s_perceivedTypes[tile_index])].Reset(tile_coord);
+		s_perceivedTypes[tile_index] = g_turnState.observedTiles[tile_index];
+		s_tilePlanes[GetTilePlaneIndex(s_perceivedTypes[tile_index])].Set(tile_coord);
+		if(was_worker_open != IsOpenTile(tile_index, true) || was_soldier_open != IsOpenTile(tile_index, false)) s_jumpTableDirty = true;
+
+		//the queen field is walked by carriers, who can not dig, so it reads the haul costs
+		const float new_worker_penalty = GetExhaustPenalty(s_perceivedTypes[tile_index], true);
+		if(new_worker_penalty > old_worker_penalty)			s_foodFieldDirty = true;
+		else if(new_worker_penalty < old_worker_penalty)	s_foodFieldLowered.push_back(tile_index);
+
+		const float new_haul_penalty = GetHaulPenalty(tile_index);
+		if(new_haul_penalty > old_haul_penalty)			s_queenFieldDirty = true;
+		else if(new_haul_penalty < old_haul_penalty)	s_queenFieldLowered.push_back(tile_index);
+
+		const int cluster_idx = GetClusterIndex(tile_index);
+		for(int model_idx = 0; model_idx < NUM_HIERARCHY_COST_MODELS; ++model_idx)
+		{
+			s_clusters[model_idx][cluster_idx].m_isDirty = true;
+			UpdateComponentTile(tile_index, old_type, model_idx == 1);
+		}
+
+		//new stone only lengthens routes, stone that went away could make a table overestimate
+		if(s_perceivedTypes[tile_index] == TILE_TYPE_STONE)	++s_wallVersion;
+		else if(old_type == TILE_TYPE_STONE)				ClearLandmarks();
+
+		++s_regionVersion[cluster_idx];
+
+		s_changedTiles.push_back(tile_index);
+	}
+
+	const bool has_food = g_turnState.tilesThatHaveFood[tile_index];
+	if(DoesTileHaveFood(tile_index) != has_food)
+	{
+		SetTileHasFood(tile_index, has_food);
+		if(!has_food)									s_foodFieldRemoved.push_back(tile_index);
+		else if(GetFoodClaim(tile_index) == UINT_MAX)	s_foodFieldAdded.push_back(tile_index);
+	}
+
+	s_lastSeenTurn[tile_index] = g_turnState.turnNumber;
+}
+
+
+//the whole map in one vector pass, only the tiles it finds dirty take the per tile path and
+//feed the change log, the fields and the clusters. Seen tiles that did not change are not
+//touched at all, the seen mask stands in for their s_lastSeenTurn
+STATIC void Geographer::PerceiveAllTiles()
+{
+	static unsigned long long s_newSeenMask[TILE_MASK_WORDS];
+
+	const int num_dirty = TileDiff::Compare(g_turnState.observedTiles, g_turnState.tilesThatHaveFood, s_perceivedTypes,
+		s_perceivedFood, s_mapTotalSize, s_dirtyMask, s_newSeenMask, s_dirtyTiles);
+
+	//anything that just went out of sight was last seen on the previous diff
+	const int num_words = (s_mapTotalSize + 63) / 64;
+	if(s_seenMaskTurn >= 0)
+	{
+		for(int word_idx = 0; word_idx < num_words; ++word_idx)
+		{
+			s_seenMask[word_idx] &= ~s_newSeenMask[word_idx];
+		}
+
+		TileDiff::ForEachTile(s_seenMask, num_words, [](const int tile_idx)
+		{
+			s_lastSeenTurn[tile_idx] = s_seenMaskTurn;
+		});
+	}
+
+	for(int dirty_num = 0; dirty_num < num_dirty; ++dirty_num)
+	{
+		PerceiveTile(s_dirtyTiles[dirty_num]);
+	}
+
+	memcpy(s_seenMask, s_newSeenMask, num_words * sizeof(unsigned long long));
+	s_seenMaskTurn = g_turnState.turnNumber;
+}
+
+
+//writes out the s_lastSeenTurn the seen mask was standing in for, before the per tile path runs
+STATIC void Geographer::FlushSeenMask()
+{
+	if(s_seenMaskTurn < 0) return;
+
+	TileDiff::ForEachTile(s_seenMask, (s_mapTotalSize + 63) / 64, [](const int tile_idx)
+	{
+		s_lastSeenTurn[tile_idx] = s_seenMaskTurn;
+	});
+
+	memset(s_seenMask, 0, sizeof(s_seenMask));
+	s_seenMaskTurn = -1;
+}
@@ -0,0 +1,201 @@
+#include "Geographer/Geographer.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+//--------------------------------------------------------------------------
+// sharable data
+
+
+STATIC uint					Geographer::s_reservations[RESERVATION_WINDOW + 1][RESERVATION_WORDS];
+
+
+//--------------------------------------------------------------------------
+// Reservations
+
+
+//starts the turn's reservations over, queens can not share a tile so every queen in sight
+//holds its tile for the whole window
+STATIC void Geographer::ClearReservations()
+{
+	const int num_words = (s_mapTotalSize + 31) / 32;
+	for(int time_step = 0; time_step <= RESERVATION_WINDOW; ++time_step)
+	{
+		memset(s_reservations[time_step], 0, num_words * sizeof(uint));
+	}
+
+	std::vector<int> queen_tiles;
+	if(IsValidCoord(g_queenPos)) queen_tiles.push_back(GetTileIndex(g_queenPos));
+	for(int agent_idx = 0; agent_idx < g_turnState.numObservedAgents; ++agent_idx)
+	{
+		const ObservedAgent& agent = g_turnState.observedAgents[agent_idx];
+		if(agent.type == AGENT_TYPE_QUEEN) queen_tiles.push_back(GetTileIndex(IntVec2(agent.tileX, agent.tileY)));
+	}
+
+	for(const int queen_idx : queen_tiles)
+	{
+		for(int time_step = 0; time_step <= RESERVATION_WINDOW; ++time_step)
+		{
+			ReserveTile(queen_idx, time_step);
+		}
+	}
+}
+
+
+//walks the orders from the start and reserves where the ant stands after each one,
+//anything past the window is left free for whoever plans later
+STATIC void Geographer::ReservePath(const IntVec2& start, const eOrderCode* orders, const int num_orders)
+{
+	if(!IsValidCoord(start)) return;
+
+	IntVec2 coord = start;
+	ReserveTile(GetTileIndex(coord), 0);
+	for(int time_step = 1; time_step <= RESERVATION_WINDOW; ++time_step)
+	{
+		if(time_step <= num_orders)
+		{
+			const IntVec2 next_coord = GetCoordFromCardDir(orders[time_step - 1], coord);
+			if(IsValidCoord(next_coord)) coord = next_coord;
+		}
+
+		ReserveTile(GetTileIndex(coord), time_step);
+	}
+}
+
+
+//WHCA* style, the start of an already planned path is searched again through space and time
+//so it steps around tiles other ants reserved this turn, waiting in place is a move too.
+//The search has to meet the plan half a window in, which leaves the other half for waits and
+//detours, the rest of the plan is kept as is. When the window can not be cleared the plan comes
+//back untouched, a collision costs less than an ant stuck in place
+STATIC std::vector<eOrderCode> Geographer::PathfindCooperative(const IntVec2& start, 
+	const std::vector<eOrderCode>& planned_orders, const bool for_worker, const eCarryState carry_state)
+{
+	const eAgentType agent_type = for_worker ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+	IntVec2 waypoint = start;
+	int num_windowed = 0;
+	while(num_windowed < static_cast<int>(planned_orders.size()) && num_windowed < RESERVATION_WINDOW / 2)
+	{
+		const IntVec2 next_coord = GetCoordFromCardDir(planned_orders[num_windowed], waypoint);
+		if(next_coord == waypoint || !IsValidCoord(next_coord)) break;
+
+		waypoint = next_coord;
+		++num_windowed;
+	}
+
+	if(num_windowed == 0 || !IsValidCoord(start)) return planned_orders;
+
+	//space-time states live in a box centered on the start, one box per time step
+	const IntVec2 box_origin(start.x - RESERVATION_WINDOW, start.y - RESERVATION_WINDOW);
+	const int waypoint_idx = GetTileIndex(waypoint);
+	const int root_state = GetReservationState(box_origin, start, 0);
+	int goal_state = -1;
+
+	NodeRecord& root_node = GetPathingNode(root_state);
+	root_node.m_coord = start;
+	root_node.m_parentIdx = -1;
+	root_node.m_actionTook = ORDER_HOLD;
+	root_node.m_pathCost = 0;
+	root_node.m_nodeState = NodeRecord::OPEN;
+
+	s_scratch->m_openList.Clear();
+	s_scratch->m_openList.Push(root_state, NodePriority(root_state, ManhattanHeuristic(start, waypoint)));
+
+	while(s_scratch->m_openList.GetSize() > 0)
+	{
+		const int current_state = s_scratch->m_openList.Pop().m_idx;
+		NodeRecord& current_node = GetPathingNode(current_state);
+		current_node.m_nodeState = NodeRecord::CLOSED;
+		if(current_node.m_coord == waypoint)
+		{
+			goal_state = current_state;
+			break;
+		}
+
+		const int time_step = current_state / RESERVATION_BOX_AREA;
+		if(time_step == RESERVATION_WINDOW) continue;
+
+		const int current_idx = GetTileIndex(current_node.m_coord);
+
+		//waiting is tried first so it wins ties against stepping somewhere just as good
+		for(int move_idx = -1; move_idx < NUM_CARDINAL_DIRS; ++move_idx)
+		{
+			int next_idx = current_idx;
+			IntVec2 next_coord = current_node.m_coord;
+			eOrderCode next_order = ORDER_HOLD;
+			float step_cost = 1.0f;
+
+			if(move_idx >= 0)
+			{
+				if((s_neighborMask[current_idx] & (1 << move_idx)) == 0) continue;
+
+				next_idx = current_idx + s_neighborOffsets[move_idx];
+				next_order = static_cast<eOrderCode>(ORDER_MOVE_EAST + move_idx);
+				next_coord = GetCoordFromCardDir(next_order, current_node.m_coord);
+				if(!IsWalkableTile(next_idx, agent_type, carry_state)) continue;
+
+				step_cost += GetExhaustPenalty(s_perceivedTypes[next_idx], agent_type, carry_state);
+			}
+
+			//the ant has to be able to arrive where it is headed even when somebody else is there
+			if(next_idx != waypoint_idx && IsTileReserved(next_idx, time_step + 1)) continue;
+
+			const int next_state = GetReservationState(box_origin, next_coord, time_step + 1);
+			const float new_cost = current_node.m_pathCost + step_cost;
+
+			NodeRecord& next_node = GetPathingNode(next_state);
+			if(next_node.m_nodeState == NodeRecord::CLOSED || next_node.m_pathCost <= new_cost) continue;
+
+			next_node.m_coord = next_coord;
+			next_node.m_parentIdx = current_state;
+			next_node.m_actionTook = next_order;
+			next_node.m_pathCost = new_cost;
+			next_node.m_nodeState = NodeRecord::OPEN;
+			s_scratch->m_openList.Push(next_state, NodePriority(next_state, new_cost + ManhattanHeuristic(next_coord, waypoint)));
+		}
+	}
+
+	if(goal_state == -1)
+	{
+		ResetPathingMap();
+		return planned_orders;
+	}
+
+	std::vector<eOrderCode> order_list;
+	for(int state_idx = goal_state; state_idx != root_state; state_idx = GetPathingNode(state_idx).m_parentIdx)
+	{
+		order_list.push_back(GetPathingNode(state_idx).m_actionTook);
+	}
+
+	std::reverse(order_list.begin(), order_list.end());
+	order_list.insert(order_list.end(), planned_orders.begin() + num_windowed, planned_orders.end());
+
+	ResetPathingMap();
+	return order_list;
+}
+
+
+//--------------------------------------------------------------------------
+// Reservation helpers
+
+
+STATIC bool Geographer::IsTileReserved(const int tile_index, const int time_step)
+{
+	return (s_reservations[time_step][tile_index >> 5] & (1u << (tile_index & 31))) != 0;
+}
+
+
+STATIC void Geographer::ReserveTile(const int tile_index, const int time_step)
+{
+	s_reservations[time_step][tile_index >> 5] |= 1u << (tile_index & 31);
+}
+
+
+//space-time state for a coord inside the box a cooperative search runs in, small enough to
+//key the shared pathing map and open list
+STATIC int Geographer::GetReservationState(const IntVec2& box_origin, const IntVec2& coord, const int time_step)
+{
+	const int box_x = coord.x - box_origin.x;
+	const int box_y = coord.y - box_origin.y;
+	return time_step * RESERVATION_BOX_AREA + box_y * RESERVATION_BOX_WIDTH + box_x;
+}
@@ -0,0 +1,135 @@
+#include "Geographer/MapSnapshot.hpp"
+#include <cstring>
+#include <utility>
+
+
+MapSnapshot::MapSnapshot(std::shared_ptr<const MapVersion> version)
+	: m_version(std::move(version))
+{
+}
+
+
+//--------------------------------------------------------------------------
+// accessors
+
+
+bool MapSnapshot::IsValid() const
+{
+	return m_version != nullptr;
+}
+
+
+//-1 for a handle taken before the first version was published
+int MapSnapshot::GetVersionNumber() const
+{
+	if(m_version == nullptr) return -1;
+	return m_version->m_versionNumber;
+}
+
+
+//the width of the map this version was published from, 0 before the first version
+int MapSnapshot::GetMapDimensions() const
+{
+	if(m_version == nullptr) return 0;
+	return m_version->m_mapDimensions;
+}
+
+
+eTileType MapSnapshot::GetTileType(const int tile_index) const
+{
+	int slot_idx;
+	const MapChunk& chunk = GetChunk(tile_index, slot_idx);
+	return chunk.m_tileTypes[slot_idx];
+}
+
+
+bool MapSnapshot::DoesTileHaveFood(const int tile_index) const
+{
+	int slot_idx;
+	const MapChunk& chunk = GetChunk(tile_index, slot_idx);
+	return (chunk.m_food[slot_idx / 64] >> (slot_idx % 64)) & 1;
+}
+
+
+//--------------------------------------------------------------------------
+// publishing
+
+
+//a new root over the previous version's chunks, only the dirty ones are built again. A map of
+//another size shares nothing, every chunk is built
+std::shared_ptr<const MapVersion> MapSnapshot::Publish(const std::shared_ptr<const MapVersion>& previous,
+	const eTileType* tile_types, const unsigned long long* food_mask, const int map_dimensions,
+	const bool* is_chunk_dirty, const int version_number)
+{
+	std::shared_ptr<MapVersion> version = std::make_shared<MapVersion>();
+	version->m_mapDimensions = map_dimensions;
+	version->m_chunksPerRow = (map_dimensions + MAP_CHUNK_WIDTH - 1) / MAP_CHUNK_WIDTH;
+	version->m_versionNumber = version_number;
+
+	const bool is_same_size = previous != nullptr && previous->m_mapDimensions == map_dimensions;
+	const int num_chunks = version->m_chunksPerRow * version->m_chunksPerRow;
+	for(int chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+	{
+		if(is_same_size && !is_chunk_dirty[chunk_idx])
+		{
+			version->m_chunks[chunk_idx] = previous->m_chunks[chunk_idx];
+			continue;
+		}
+
+		std::shared_ptr<MapChunk> chunk = std::make_shared<MapChunk>();
+		BuildChunk(*chunk, tile_types, food_mask, map_dimensions,
+			(chunk_idx % version->m_chunksPerRow) * MAP_CHUNK_WIDTH, (chunk_idx / version->m_chunksPerRow) * MAP_CHUNK_WIDTH);
+		version->m_chunks[chunk_idx] = std::move(chunk);
+	}
+
+	return version;
+}
+
+
+int MapSnapshot::GetChunkIndex(const int tile_index, const int map_dimensions)
+{
+	const int chunks_per_row = (map_dimensions + MAP_CHUNK_WIDTH - 1) / MAP_CHUNK_WIDTH;
+	const int x_idx = tile_index % map_dimensions;
+	const int y_idx = tile_index / map_dimensions;
+	return (y_idx / MAP_CHUNK_WIDTH) * chunks_per_row + x_idx / MAP_CHUNK_WIDTH;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+const MapChunk& MapSnapshot::GetChunk(const int tile_index, int& out_slot) const
+{
+	const int x_idx = tile_index % m_version->m_mapDimensions;
+	const int y_idx = tile_index / m_version->m_mapDimensions;
+	out_slot = (y_idx % MAP_CHUNK_WIDTH) * MAP_CHUNK_WIDTH + x_idx % MAP_CHUNK_WIDTH;
+
+	const int chunk_idx = (y_idx / MAP_CHUNK_WIDTH) * m_version->m_chunksPerRow + x_idx / MAP_CHUNK_WIDTH;
+	return *m_version->m_chunks[chunk_idx];
+}
+
+
+//copies a row of tile bytes at a time, whatever hangs off the map edge reads as unseen
+void MapSnapshot::BuildChunk(MapChunk& out_chunk, const eTileType* tile_types, const unsigned long long* food_mask,
+	const int map_dimensions, const int min_x, const int min_y)
+{
+	memset(out_chunk.m_tileTypes, TILE_TYPE_UNSEEN, sizeof(out_chunk.m_tileTypes));
+	memset(out_chunk.m_food, 0, sizeof(out_chunk.m_food));
+
+	const int row_width = map_dimensions - min_x < MAP_CHUNK_WIDTH ? map_dimensions - min_x : MAP_CHUNK_WIDTH;
+	for(int row_idx = 0; row_idx < MAP_CHUNK_WIDTH && min_y + row_idx < map_dimensions; ++row_idx)
+	{
+		const int row_start_idx = (min_y + row_idx) * map_dimensions + min_x;
+		memcpy(&out_chunk.m_tileTypes[row_idx * MAP_CHUNK_WIDTH], &tile_types[row_start_idx], row_width * sizeof(eTileType));
+
+		for(int column_idx = 0; column_idx < row_width; ++column_idx)
+		{
+			const int tile_idx = row_start_idx + column_idx;
+			if(((food_mask[tile_idx / 64] >> (tile_idx % 64)) & 1) == 0) continue;
+
+			const int slot_idx = row_idx * MAP_CHUNK_WIDTH + column_idx;
+			out_chunk.m_food[slot_idx / 64] |= 1ull << (slot_idx % 64);
+		}
+	}
+}
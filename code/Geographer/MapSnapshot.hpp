@@ -0,0 +1,58 @@
+#pragma once
+#include "Arena/ArenaPlayerInterface.hpp"
+#include <memory>
+
+//the published map is cut into square chunks, so a new version only builds the chunks that
+//changed and shares every other one with the version before it
+constexpr int MAP_CHUNK_WIDTH = 16;
+constexpr int MAP_CHUNK_TILES = MAP_CHUNK_WIDTH * MAP_CHUNK_WIDTH;
+constexpr int MAX_CHUNKS_PER_ROW = (MAX_ARENA_WIDTH + MAP_CHUNK_WIDTH - 1) / MAP_CHUNK_WIDTH;
+constexpr int MAX_MAP_CHUNKS = MAX_CHUNKS_PER_ROW * MAX_CHUNKS_PER_ROW;
+
+//one chunk's tiles row by row, food a bit per tile. Tiles past the map edge read as unseen.
+//Nothing writes a chunk once it is published
+struct MapChunk
+{
+	eTileType			m_tileTypes[MAP_CHUNK_TILES];
+	unsigned long long	m_food[MAP_CHUNK_TILES / 64];
+};
+
+//the root of one published version, chunks are shared with the versions either side of it
+struct MapVersion
+{
+	std::shared_ptr<const MapChunk>	m_chunks[MAX_MAP_CHUNKS];
+	int		m_mapDimensions = 0;
+	int		m_chunksPerRow = 0;
+	int		m_versionNumber = 0;
+};
+
+//a handle on one published version of the perceived map. Taking one is a reference count, and
+//it keeps reading the same map however many versions are published while it is held
+class MapSnapshot
+{
+public:
+	MapSnapshot() = default;
+	explicit MapSnapshot(std::shared_ptr<const MapVersion> version);
+	~MapSnapshot() = default;
+
+	//accessors
+	bool		IsValid() const;
+	int			GetVersionNumber() const;
+	int			GetMapDimensions() const;
+	eTileType	GetTileType(int tile_index) const;
+	bool		DoesTileHaveFood(int tile_index) const;
+
+	//publishing
+	static std::shared_ptr<const MapVersion>	Publish(const std::shared_ptr<const MapVersion>& previous,
+													const eTileType* tile_types, const unsigned long long* food_mask,
+													int map_dimensions, const bool* is_chunk_dirty, int version_number);
+	static int									GetChunkIndex(int tile_index, int map_dimensions);
+
+private:
+	const MapChunk&	GetChunk(int tile_index, int& out_slot) const;
+	static void		BuildChunk(MapChunk& out_chunk, const eTileType* tile_types, const unsigned long long* food_mask,
+						int map_dimensions, int min_x, int min_y);
+
+private:
+	std::shared_ptr<const MapVersion>	m_version;
+};
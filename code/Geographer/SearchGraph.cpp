@@ -1,12 +1,14 @@
 #include "Geographer/SearchGraph.hpp"
 #include "Architecture/Queue.hpp"
 #include "Architecture/QueueIterator.hpp"
+#include "Geographer/BitBoard.hpp"
 #include <string>
 
 
-SearchGraph::SearchGraph(eQueueType queue_type, const TileRecord map[MAX_ARENA_TILES])
+SearchGraph::SearchGraph(eQueueType queue_type, const MapSnapshot& map)
+	: m_map(map)
 {
-	memcpy(m_map, map, Geographer::s_mapDimensions * sizeof(TileRecord));
+	m_versionNumber = m_map.GetVersionNumber();
 
 	switch(queue_type)
 	{
@@ -24,81 +26,55 @@ SearchGraph::SearchGraph(eQueueType queue_type, const TileRecord map[MAX_ARENA_T
 		{
 			break;
 		}
+	case QUEUE_BUCKET:
+		{
+			m_frontierIterator = m_frontier.CreateBucketIterator();
+			break;
+		}
 	}
 }
 
 
 SearchGraph::~SearchGraph()
 {
+	delete m_frontierIterator;
+	m_frontierIterator = nullptr;
 }
 
-bool SearchGraph::FloodFill( std::vector<TileRecord>& out_tiles, const short start_tile_index,
+//every tile within depth steps of the start, nearest first. The whole ring at each step is
+//found in one bitboard pass, the tiles themselves are only visited to record them. Only the
+//snapshot is read, so the fill sees one map however far perception has moved on since
+bool SearchGraph::FloodFill( std::vector<TileRecord>& out_tiles, const int start_tile_index,
                              const int depth )
 {
-	//start node
-	const short root_idx = start_tile_index;
-	m_searchSpace[root_idx].m_parentIdx = -1;
-	m_searchSpace[root_idx].m_actionTook = ORDER_HOLD;
-	m_searchSpace[root_idx].m_pathCost = 0;
-	m_searchSpace[root_idx].m_inOpenList = true;
-	m_searchSpace[root_idx].m_inClosedList = false;
-	
-	
-	if(m_searchSpace[root_idx].m_pathCost > depth)
+	if(!m_map.IsValid()) return false;
+
+	const int map_dimensions = m_map.GetMapDimensions();
+	if(start_tile_index < 0 || start_tile_index >= map_dimensions * map_dimensions) return false;
+
+	const IntVec2 start(start_tile_index % map_dimensions, start_tile_index / map_dimensions);
+	m_wholeMap.Fill(map_dimensions);
+	BitBoard::ForEachLayer(start, m_wholeMap, depth, m_reached, m_layers,
+		[&](const int x_idx, const int y_idx, const int steps)
 	{
-		TileRecord new_tile;
-		new_tile.m_tileType =  g_turnState.observedTiles[root_idx];
-		new_tile.m_hasFood = g_turnState.tilesThatHaveFood[root_idx];
-		new_tile.m_lastUpdated = g_turnState.turnNumber;
-
-		out_tiles.push_back(new_tile);
-		return true;
-	};
-
-	m_frontierIterator->Push(root_idx);
-
-	//while(!m_frontier->IsEmpty())
-	//{
-		const short node_idx = m_frontierIterator->Peak();
-		m_frontierIterator->Pop();
-		
-		//update node and add it to the closed list
+		const int tile_idx = y_idx * map_dimensions + x_idx;
+		m_searchSpace[tile_idx].m_pathCost = static_cast<float>(steps);
+		m_searchSpace[tile_idx].m_inClosedList = true;
+
 		TileRecord new_tile_info;
-		new_tile_info.m_tileType = g_turnState.observedTiles[node_idx];
-		new_tile_info.m_hasFood = g_turnState.tilesThatHaveFood[node_idx];
+		new_tile_info.m_tileType = m_map.GetTileType(tile_idx);
+		new_tile_info.m_hasFood = m_map.DoesTileHaveFood(tile_idx);
 		new_tile_info.m_lastUpdated = g_turnState.turnNumber;
 		out_tiles.push_back(new_tile_info);
-		m_searchSpace[node_idx].m_inClosedList = true;
-
-		//TODO:check goal (easy for breadth-first-search, need to look at depth-first-search)
-		//if(m_searchSpace[node_idx].m_pathCost > depth) break;
-
-		//expand node and look at neighbors
-		std::vector<short> neighboring_node_idx = GetNeighbors(node_idx);
-		const int num_neighbors = static_cast<int>(neighboring_node_idx.size());
-		for(int neighbor_idx = 0; neighbor_idx < num_neighbors; ++neighbor_idx)
-		{
-			if(neighboring_node_idx[neighbor_idx] == -1) continue;
-			const short child_node_idx = neighboring_node_idx[neighbor_idx];
-
-			if(	!m_searchSpace[child_node_idx].m_inOpenList || 
-				!m_searchSpace[child_node_idx].m_inClosedList)
-			{
-				m_searchSpace[child_node_idx].m_parentIdx = node_idx;
-				m_searchSpace[child_node_idx].m_actionTook = static_cast<eOrderCode>(neighbor_idx + 1);;
-				m_searchSpace[child_node_idx].m_pathCost = m_searchSpace[node_idx].m_pathCost + 1;
-				m_searchSpace[child_node_idx].m_inOpenList = true;
-			}
-		}
-	//}
+	});
 
 	DebugPrintCostMap();
 	
 	return true;
 }
 
-bool SearchGraph::Path( std::vector<eOrderCode>& out_orders, const short start_tile_index, 
-						const short end_tile_index )
+bool SearchGraph::Path( std::vector<eOrderCode>& out_orders, const int start_tile_index, 
+						const int end_tile_index )
 {
 
 	return false;
@@ -111,34 +87,6 @@ int SearchGraph::TotalNodesToSearch(int depth)
 
 //-----------------------------------------------------------------
 // Helper functions
-std::vector<short> SearchGraph::GetNeighbors(const short idx_coord)
-{
-	const IntVec2 coord = Geographer::GetTileCoord(idx_coord);
-
-	IntVec2 dir[] = {
-		IntVec2(1, 0),	//East
-		IntVec2(0, 1),	//North
-		IntVec2(-1, 0),	//West
-		IntVec2(0, -1)}; //South
-
-	std::vector<short> result = std::vector<short>();
-
-	for (auto& idx : dir)
-	{
-		IntVec2 test_coord(coord.x + idx.x, coord.y + idx.y);
-		if(!Geographer::IsValidCoord(test_coord))
-		{
-			result.emplace_back(-1);
-			continue;
-		};
-
-		short valid_idx = Geographer::GetTileIndex(test_coord);
-		result.emplace_back(valid_idx);
-	}
-
-	return result;
-}
-
 void SearchGraph::DebugPrintCostMap()
 {
 	for(short node_idx = 0; node_idx > Geographer::s_mapTotalSize; ++node_idx)
@@ -1,6 +1,7 @@
 #pragma once
 #include "Arena/ArenaPlayerInterface.hpp"
 #include "Geographer/Geographer.hpp"
+#include "Geographer/MapSnapshot.hpp"
 #include "Architecture/Queue.hpp"
 
 class Queue;
@@ -19,21 +20,26 @@ class SearchGraph
 	
 public:
 	// Graph (with a version number)
-	TileRecord	m_map[MAX_ARENA_TILES];
+	MapSnapshot	m_map;
 	NodeRecord	m_searchSpace[MAX_ARENA_TILES];
 	int			m_versionNumber = 0;
 
 	// list of indexs to potentially search
 	Queue			m_frontier;
 	QueueIterator*	m_frontierIterator = nullptr;
+
+	// flood fill planes
+	BitBoard		m_wholeMap;
+	BitBoard		m_reached;
+	BitBoard		m_layers[2];
 	
 public:
-	SearchGraph(eQueueType queue_type, const TileRecord map[MAX_ARENA_TILES]);
+	SearchGraph(eQueueType queue_type, const MapSnapshot& map);
 	~SearchGraph();
 
 	//function GRAPH-SEARCH(problem) returns a solution, or failure
-	bool FloodFill( std::vector<TileRecord>& out_tiles, short start_tile_index, int depth );
-	bool Path( std::vector<eOrderCode>& out_orders, short start_tile_index, short end_tile_index );
+	bool FloodFill( std::vector<TileRecord>& out_tiles, int start_tile_index, int depth );
+	bool Path( std::vector<eOrderCode>& out_orders, int start_tile_index, int end_tile_index );
 
 	// Debug drawing
 	void DebugPrintCostMap();
@@ -41,6 +47,5 @@ public:
 	void DebugPrintPath();
 	
 private:
-	std::vector<short>	GetNeighbors( short idx_coord);
 	int					TotalNodesToSearch(int depth);
 };
@@ -0,0 +1,118 @@
+#include "Geographer/TileDiff.hpp"
+#include <cstring>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//AVX2 builds take 32 tiles a step, anything else takes the 16 every x64 target has in SSE2
+#if defined(__AVX2__)
+constexpr int BLOCK_TILES = 32;
+#else
+constexpr int BLOCK_TILES = 16;
+#endif
+
+
+//--------------------------------------------------------------------------
+// kernels
+
+
+//writes the masks and the dirty tiles in index order in a single pass, returns how many changed
+int TileDiff::Compare(const eTileType* observed_types, const bool* observed_food, const eTileType* known_types,
+	const unsigned long long* known_food_mask, const int num_tiles, unsigned long long* out_dirty_mask, unsigned long long* out_seen_mask,
+	int* out_changed)
+{
+	const int num_words = (num_tiles + 63) / 64;
+	memset(out_dirty_mask, 0, num_words * sizeof(unsigned long long));
+	memset(out_seen_mask, 0, num_words * sizeof(unsigned long long));
+
+	const unsigned char* observed_type_bytes = reinterpret_cast<const unsigned char*>(observed_types);
+	const unsigned char* observed_food_bytes = reinterpret_cast<const unsigned char*>(observed_food);
+	const unsigned char* known_type_bytes = reinterpret_cast<const unsigned char*>(known_types);
+
+	int num_changed = 0;
+	int tile_idx = 0;
+	for(; tile_idx + BLOCK_TILES <= num_tiles; tile_idx += BLOCK_TILES)
+	{
+		//a block never straddles a word, 64 is a multiple of the block size
+		const int word_idx = tile_idx / 64;
+		const int bit_offset = tile_idx % 64;
+		const unsigned int known_food_bits = static_cast<unsigned int>(known_food_mask[word_idx] >> bit_offset);
+
+		unsigned int seen_bits = 0;
+		unsigned int dirty_bits = CompareBlock(observed_type_bytes + tile_idx, observed_food_bytes + tile_idx,
+			known_type_bytes + tile_idx, known_food_bits, seen_bits);
+		out_seen_mask[word_idx] |= static_cast<unsigned long long>(seen_bits) << bit_offset;
+		out_dirty_mask[word_idx] |= static_cast<unsigned long long>(dirty_bits) << bit_offset;
+
+		while(dirty_bits != 0)
+		{
+			out_changed[num_changed++] = tile_idx + LowestBit(dirty_bits);
+			dirty_bits &= dirty_bits - 1;
+		}
+	}
+
+	//whatever is left of a map whose size is not a multiple of the block
+	for(; tile_idx < num_tiles; ++tile_idx)
+	{
+		if(observed_types[tile_idx] == TILE_TYPE_UNSEEN) continue;
+
+		out_seen_mask[tile_idx / 64] |= 1ull << (tile_idx % 64);
+		const bool known_food = (known_food_mask[tile_idx / 64] >> (tile_idx % 64)) & 1;
+		if(observed_types[tile_idx] == known_types[tile_idx] && observed_food[tile_idx] == known_food) continue;
+
+		out_dirty_mask[tile_idx / 64] |= 1ull << (tile_idx % 64);
+		out_changed[num_changed++] = tile_idx;
+	}
+
+	return num_changed;
+}
+
+
+//--------------------------------------------------------------------------
+// helpers
+
+
+//one bit per tile of the block. The server's food bools are squeezed down to a bit a tile,
+//so they compare against the remembered mask with a single xor
+unsigned int TileDiff::CompareBlock(const unsigned char* observed_types, const unsigned char* observed_food,
+	const unsigned char* known_types, const unsigned int known_food_bits, unsigned int& out_seen_bits)
+{
+#if defined(__AVX2__)
+	const __m256i unseen = _mm256_set1_epi8(static_cast<char>(TILE_TYPE_UNSEEN));
+	const __m256i observed_type = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(observed_types));
+	const __m256i same_type = _mm256_cmpeq_epi8(observed_type,
+		_mm256_loadu_si256(reinterpret_cast<const __m256i*>(known_types)));
+	const __m256i no_food = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(observed_food)),
+		_mm256_setzero_si256());
+
+	out_seen_bits = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(observed_type, unseen)));
+	const unsigned int same_type_bits = static_cast<unsigned int>(_mm256_movemask_epi8(same_type));
+	const unsigned int food_bits = ~static_cast<unsigned int>(_mm256_movemask_epi8(no_food));
+#else
+	const __m128i unseen = _mm_set1_epi8(static_cast<char>(TILE_TYPE_UNSEEN));
+	const __m128i observed_type = _mm_loadu_si128(reinterpret_cast<const __m128i*>(observed_types));
+	const __m128i same_type = _mm_cmpeq_epi8(observed_type,
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(known_types)));
+	const __m128i no_food = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(observed_food)),
+		_mm_setzero_si128());
+
+	out_seen_bits = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(observed_type, unseen))) & 0xFFFFu;
+	const unsigned int same_type_bits = static_cast<unsigned int>(_mm_movemask_epi8(same_type));
+	const unsigned int food_bits = ~static_cast<unsigned int>(_mm_movemask_epi8(no_food)) & 0xFFFFu;
+#endif
+
+	return out_seen_bits & (~same_type_bits | (food_bits ^ known_food_bits));
+}
+
+
+int TileDiff::LowestBit(const unsigned long long bits)
+{
+#if defined(_MSC_VER)
+	unsigned long bit_idx;
+	_BitScanForward64(&bit_idx, bits);
+	return static_cast<int>(bit_idx);
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
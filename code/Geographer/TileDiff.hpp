@@ -0,0 +1,40 @@
+#pragma once
+#include "Arena/ArenaPlayerInterface.hpp"
+
+//one bit per tile in tile index order, bit (index % 64) of word (index / 64)
+constexpr int TILE_MASK_WORDS = (MAX_ARENA_TILES + 63) / 64;
+
+//compares what the server shows us against what we remember, a vector register of tiles at
+//a time. A tile is seen when it is not TILE_TYPE_UNSEEN, and dirty when it is seen and its
+//type or food differs from the remembered one. Remembered food is a mask in the layout above
+class TileDiff
+{
+public:
+	static int	Compare(const eTileType* observed_types, const bool* observed_food,
+					const eTileType* known_types, const unsigned long long* known_food_mask, int num_tiles,
+					unsigned long long* out_dirty_mask, unsigned long long* out_seen_mask, int* out_changed);
+
+	template <typename Visitor>
+	static void	ForEachTile(const unsigned long long* mask, int num_words, Visitor visit);
+
+private:
+	static unsigned int	CompareBlock(const unsigned char* observed_types, const unsigned char* observed_food,
+							const unsigned char* known_types, unsigned int known_food_bits, unsigned int& out_seen_bits);
+	static int			LowestBit(unsigned long long bits);
+};
+
+
+//visit(tile_index) for every set bit of the mask, lowest index first
+template <typename Visitor>
+void TileDiff::ForEachTile(const unsigned long long* mask, const int num_words, Visitor visit)
+{
+	for(int word_idx = 0; word_idx < num_words; ++word_idx)
+	{
+		unsigned long long word = mask[word_idx];
+		while(word != 0)
+		{
+			visit(word_idx * 64 + LowestBit(word));
+			word &= word - 1;
+		}
+	}
+}
@@ -3,6 +3,7 @@
 #include "Geographer/Geographer.hpp"
 #include "Character/AntUnit.hpp"
 #include "Architecture/AntPool.hpp"
+#include "Architecture/ContainerChecks.hpp"
 
 STATIC MainThread* MainThread::s_mainThreadInstance = nullptr;
 
@@ -27,12 +28,24 @@ STATIC void MainThread::DeleteInstance()
 
 
 MainThread::MainThread() = default;
-MainThread::~MainThread() = default;
+
+
+//only deleted once every player thread has returned, so no search still holds a scratch
+MainThread::~MainThread()
+{
+	for (PathingScratch* scratch : m_pathingScratch)
+	{
+		delete scratch;
+	}
+	m_pathingScratch.clear();
+}
 
 
 void MainThread::Startup( const StartupInfo& info )
 {
 	g_matchInfo = info.matchInfo;
+	g_playerInfo = info.yourPlayerInfo;
+	g_maxTurnSeconds = info.maxTurnSeconds;
 	g_debugInterface = info.debugInterface;
 	
 	// Optional Todo: Can register into the dev-console system
@@ -42,19 +55,38 @@ void MainThread::Startup( const StartupInfo& info )
 	g_turnState.turnNumber = -1; 
 	m_lastTurnProcessed = -1; 
 	m_numActiveThreads = 0;
+	m_numThreads = info.expectedThreadCount > 1 ? info.expectedThreadCount : 1;
+	m_nextPathingJob = 0;
+	m_numPathingJobsDone = 0;
+	m_numBusyHelpers = 0;
 	m_running = true;
 
+	for (int thread_idx = 0; thread_idx < m_numThreads; ++thread_idx)
+	{
+		m_pathingScratch.push_back(new PathingScratch());
+	}
+
 	m_hive = std::map<AgentID, AntUnit*>();
 	m_antPool = new AntPool();
 	
+#if defined( RUN_SELF_CHECKS )
+	RunContainerChecks();
+	Geographer::CheckPathCosts();
+#endif
+
 	Geographer::Startup();
 }
 
 
 void MainThread::Shutdown( const MatchResults& results )
 {	
-	m_running = false;
+	//cleared under both locks, so no thread can test it and then miss the wake up below
+	{
+		std::scoped_lock lk( m_turnLock, m_batchLock );
+		m_running = false;
+	}
 	m_turnCV.notify_all();
+	m_batchCV.notify_all();
 	
 	Geographer::Shutdown();
 
@@ -63,12 +95,13 @@ void MainThread::Shutdown( const MatchResults& results )
 }
 
 
-void MainThread::ThreadEntry( int /*threadIdx*/ )
+void MainThread::ThreadEntry( int threadIdx )
 {
 	// wait for data
 	// process turn
 	// mark turn as finished;
 	++m_numActiveThreads;
+	Geographer::BindPathingScratch( m_pathingScratch[threadIdx] );
 	ArenaTurnStateForPlayer turn_state;
 	
 	while (m_running) 
@@ -96,6 +129,36 @@ void MainThread::ThreadEntry( int /*threadIdx*/ )
 }
 
 
+//every thread past the first sleeps until a repath batch is posted and helps plan it
+void MainThread::HelperThreadEntry( int threadIdx )
+{
+	++m_numActiveThreads;
+	Geographer::BindPathingScratch( m_pathingScratch[threadIdx] );
+	int last_batch = 0;
+
+	while (m_running)
+	{
+		std::unique_lock lk( m_batchLock );
+		m_batchCV.wait( lk, [&]() { return !m_running || m_batchNumber != last_batch; } );
+		if (!m_running) break;
+
+		//counted as busy before the lock drops, so the next batch can not swap the jobs out from under us
+		last_batch = m_batchNumber;
+		++m_numBusyHelpers;
+		lk.unlock();
+
+		WorkOnPathingJobs();
+
+		lk.lock();
+		--m_numBusyHelpers;
+		lk.unlock();
+		m_batchDoneCV.notify_all();
+	}
+
+	--m_numActiveThreads;
+}
+
+
 // This has to finish in less than 1MS otherwise you will be faulted
 void MainThread::ReceiveTurnState(const ArenaTurnStateForPlayer& state)
 {
@@ -156,17 +219,76 @@ void MainThread::ProcessTurn( ArenaTurnStateForPlayer& turn_state )
 		
 	}
 
-	// Act
+	// Act, every player thread plans a share of the repaths, then they are applied in request order
+	// so the reservations and orders come out the same however the work was split
+	std::vector<PathingJob> pathing_jobs;
 	while(g_pathingRequests.GetSize() != 0)
 	{
 		RepathPriority current_pathing_job = g_pathingRequests.Pop();
-		if (g_numRepaths <= MAX_REPATHING)
+
+		PathingJob job;
+		job.m_ant = m_hive[current_pathing_job.m_id];
+		if (job.m_ant->NeedsPath() && g_numRepaths <= MAX_REPATHING * m_numThreads)
 		{
-			m_hive[current_pathing_job.m_id]->UpdatePath();
+			job.m_needsPlan = true;
 			++g_numRepaths;
 		}
-		m_hive[current_pathing_job.m_id]->ContinuePath();
+		pathing_jobs.push_back(job);
+	}
+
+	Geographer::PrepareForPathingBatch(ANT_PATHING_STRATEGY);
+	RunPathingBatch(pathing_jobs);
+
+	Geographer::ClearReservations();
+	for (PathingJob& job : m_pathingJobs)
+	{
+		if (job.m_needsPlan) job.m_ant->ApplyPath(job.m_orders);
+		job.m_ant->ContinuePath();
+	}
+}
+
+
+//posts the jobs to the helpers and works on them here as well, returns once every job is planned
+void MainThread::RunPathingBatch( std::vector<PathingJob>& jobs )
+{
+	std::unique_lock lk( m_batchLock );
+
+	//a helper still leaving the last batch reads its jobs, they can not be swapped out until it is gone
+	m_batchDoneCV.wait( lk, [&]() { return m_numBusyHelpers == 0; } );
+	m_pathingJobs.swap(jobs);
+	m_nextPathingJob = 0;
+	m_numPathingJobsDone = 0;
+	++m_batchNumber;
+	lk.unlock();
+	m_batchCV.notify_all();
+
+	WorkOnPathingJobs();
+
+	lk.lock();
+	m_batchDoneCV.wait( lk, [&]() { return m_numPathingJobsDone == static_cast<int>(m_pathingJobs.size()); } );
+}
+
+
+//each job is claimed once through the shared counter, the results land in the job itself.
+//The finished jobs are counted once at the end so the lock is only taken once per thread
+void MainThread::WorkOnPathingJobs()
+{
+	const int num_jobs = static_cast<int>(m_pathingJobs.size());
+	int num_finished = 0;
+	for (int job_idx = m_nextPathingJob++; job_idx < num_jobs; job_idx = m_nextPathingJob++)
+	{
+		PathingJob& job = m_pathingJobs[job_idx];
+		if (job.m_needsPlan) job.m_orders = job.m_ant->PlanPath();
+		++num_finished;
+	}
+
+	if (num_finished == 0) return;
+
+	{
+		std::unique_lock lk( m_batchLock );
+		m_numPathingJobsDone += num_finished;
 	}
+	m_batchDoneCV.notify_all();
 }
 
 
@@ -3,9 +3,20 @@
 #include <mutex>
 #include <atomic>
 #include <map>
+#include <vector>
+#include <condition_variable>
 
 class AntUnit;
 class AntPool;
+struct PathingScratch;
+
+//one ant in the turn's repath batch, m_orders is filled by whichever thread plans it
+struct PathingJob
+{
+	AntUnit*				m_ant = nullptr;
+	bool					m_needsPlan = false;
+	std::vector<eOrderCode>	m_orders;
+};
 
 class MainThread
 {
@@ -17,10 +28,22 @@ public:
 	int									m_lastTurnProcessed;
 
 	//threading variables
-	bool								m_running;
+	std::atomic<bool>					m_running;
 	std::mutex							m_turnLock;
 	std::condition_variable				m_turnCV;
 	std::atomic<int>					m_numActiveThreads;
+	int									m_numThreads = 1;
+
+	//repath batch, helpers claim jobs through m_nextPathingJob, the counts below it are guarded by m_batchLock
+	std::vector<PathingJob>				m_pathingJobs;
+	std::mutex							m_batchLock;
+	std::condition_variable				m_batchCV;
+	std::condition_variable				m_batchDoneCV;
+	int									m_batchNumber = 0;
+	std::atomic<int>					m_nextPathingJob;
+	int									m_numPathingJobsDone = 0;
+	int									m_numBusyHelpers = 0;
+	std::vector<PathingScratch*>		m_pathingScratch;	//one per player thread, indexed by thread index
 	
 	std::map<AgentID, AntUnit*>			m_hive;
 	AntPool*							m_antPool;
@@ -39,6 +62,7 @@ public:
 	void Startup( const StartupInfo& info );
 	void Shutdown( const MatchResults& results ); 
 	void ThreadEntry( int threadIdx ); 
+	void HelperThreadEntry( int threadIdx );
 	void ReceiveTurnState( const ArenaTurnStateForPlayer& state );
 	bool TurnOrderRequest( PlayerTurnOrders* orders ); 
 	void AddOrder(AgentID agent, eOrderCode order);
@@ -51,5 +75,8 @@ private:
 	
 private:
 	MainThread();
+
+	void RunPathingBatch( std::vector<PathingJob>& jobs );
+	void WorkOnPathingJobs();
 	
 }; 
\ No newline at end of file
@@ -35,12 +35,16 @@ void PostGameShutdown( const MatchResults& results )
 // get the threads, and add them to a pool
 void PlayerThreadEntry( int yourThreadIdx )
 {
-	// this Ai is "bad" - I'm only going to use one worker thread
+	// thread 0 runs the turns, the rest help plan each turn's repaths
+	MainThread* the_player = MainThread::GetInstance();
 	if (yourThreadIdx == 0) 
 	{
-		MainThread* the_player = MainThread::GetInstance();
 		the_player->ThreadEntry( yourThreadIdx );
 	}
+	else
+	{
+		the_player->HelperThreadEntry( yourThreadIdx );
+	}
 }
 
 